@@ -144,14 +144,15 @@ namespace game
 						const auto numCols = message->data[1];
 						const auto numRows = message->data[2];
 						const auto first = message->data[3];
+						const auto winLength = message->data[4] != 0 ? message->data[4] : FourAcross::defaultWinLength;
 						printDebug(
 							"Client is in a lobby that has started playing with "
 							, static_cast<int>(numPlayers), " players\n");
 						printDebug(
 							"Board size is set to cols=", static_cast<int>(numCols), ", rows=",
-							static_cast<int>(numRows), "\n");
+							static_cast<int>(numRows), ", win length=", static_cast<int>(winLength), "\n");
 
-						startGame(numPlayers, first, numCols, numRows);
+						startGame(numPlayers, first, numCols, numRows, winLength);
 					}
 					break;
 					case MessageType::gameEnd:
@@ -272,10 +273,10 @@ namespace game
 				sendMessage(message);
 			}
 
-			void Client::startGame(uint8_t numPlayers, uint8_t first, uint8_t cols, uint8_t rows)
+			void Client::startGame(uint8_t numPlayers, uint8_t first, uint8_t cols, uint8_t rows, uint8_t winLength)
 			{
-				game.reset(new FourAcross{numPlayers, first, cols, rows});
-				onGameStart(numPlayers, first, cols, rows);
+				game.reset(new FourAcross{numPlayers, first, cols, rows, winLength});
+				onGameStart(numPlayers, first, cols, rows, winLength);
 			}
 
 			void Client::stopGame(uint8_t winner)
@@ -52,12 +52,13 @@ void ConsoleClient::onQueueUpdate(uint64_t queuePosition)
 }
 
 
-void ConsoleClient::onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows)
+void ConsoleClient::onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows, uint8_t winLength)
 {
 	// Display info about the game that just started
 	std::cout << "Your game has started with " << static_cast<int>(numPlayers) << " players.\n"
 		<< "Player " << static_cast<int>(firstPlayer) << " is first.\n"
-		<< "The board size is " << static_cast<int>(cols) << "x" << static_cast<int>(rows) << "\n";
+		<< "The board size is " << static_cast<int>(cols) << "x" << static_cast<int>(rows) << "\n"
+		<< "Get " << static_cast<int>(winLength) << " pieces in a line to win.\n";
 }
 
 void ConsoleClient::onGameEnd(uint8_t winner)
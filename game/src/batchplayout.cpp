@@ -0,0 +1,319 @@
+#include "four-across/game/batchplayout.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace game
+{
+	constexpr size_t BatchPlayout::numLanes;
+
+	// State of the games being played, one lane per game. Lanes without a game have a full board.
+	struct BatchPlayout::Lanes
+	{
+		alignas(32) uint64_t occupied[numLanes];
+		alignas(32) uint64_t pieces[numLanes]; // of the player to move
+		alignas(32) uint64_t otherPieces[numLanes];
+		alignas(32) uint64_t moves[numLanes]; // cell dropped in the last step, or 0
+		alignas(32) uint64_t lines[numLanes];
+		alignas(32) uint64_t rngStates[numLanes];
+		size_t positions[numLanes]; // index of the position the game started from
+		bool isSwapped[numLanes]; // the player to move isn't the one to move at the position
+	};
+
+	namespace
+	{
+		constexpr size_t noPosition{~size_t{0}};
+
+		// xorshift64, which needs only shifts and XORs so every lane advances at once
+		inline uint64_t nextRandom(uint64_t& state) noexcept
+		{
+			state ^= state << 13;
+			state ^= state >> 7;
+			state ^= state << 17;
+			return state;
+		}
+	}
+
+	BatchPlayout::BatchPlayout(uint8_t numColumns, uint8_t numRows, uint8_t winLength) :
+		numColumns{numColumns},
+		numRows{numRows},
+		winLength{winLength},
+		shifts{{1, numRows, static_cast<uint8_t>(numRows + 1), static_cast<uint8_t>(numRows - 1)}},
+		neighborMasks{},
+		lineSteps{},
+		numLineSteps{0}
+	{
+		if (numColumns < Board::minColumns || numRows < Board::minRows || numColumns - numRows < 1)
+		{
+			throw std::invalid_argument("BatchPlayout: invalid board dimensions");
+		}
+		if (numColumns * numRows > Board::maxBitboardCells)
+		{
+			throw std::invalid_argument("BatchPlayout: boards of more than 64 cells aren't supported");
+		}
+		if (winLength < FourAcross::minWinLength || winLength > numColumns)
+		{
+			throw std::invalid_argument("BatchPlayout: invalid win length");
+		}
+
+		columnBits = (uint64_t{1} << numRows) - 1;
+		const uint8_t numCells = numColumns * numRows;
+		fullMask = numCells == 64 ? ~uint64_t{0} : (uint64_t{1} << numCells) - 1;
+		for (uint8_t column = 0; column < numColumns; ++column)
+		{
+			for (uint8_t row = 0; row < numRows; ++row)
+			{
+				const uint64_t cell = uint64_t{1} << (column * numRows + row);
+				const bool hasAbove = row < numRows - 1;
+				const bool hasBelow = row > 0;
+				const bool hasRight = column < numColumns - 1;
+				neighborMasks[0] |= hasAbove ? cell : 0;
+				neighborMasks[1] |= hasRight ? cell : 0;
+				neighborMasks[2] |= hasAbove && hasRight ? cell : 0;
+				neighborMasks[3] |= hasBelow && hasRight ? cell : 0;
+			}
+		}
+
+		// same steps as Board's line check: the length found almost doubles each step
+		for (uint8_t found = 2; found < winLength;)
+		{
+			const uint8_t step = std::min<uint8_t>(found - 1, winLength - found);
+			lineSteps[numLineSteps++] = step;
+			found += step;
+		}
+	}
+
+	void BatchPlayout::playoutBatch(const FourAcross* positions, size_t numPositions, uint32_t numPlayouts,
+		std::mt19937_64& rng, PlayoutCounts* counts) const
+	{
+		for (size_t i = 0; i < numPositions; ++i)
+		{
+			const FourAcross& position = positions[i];
+			if (position.getNumPlayers() != 2 || position.getNumColumns() != numColumns ||
+				position.getNumRows() != numRows || position.getWinLength() != winLength)
+			{
+				throw std::invalid_argument("BatchPlayout::playoutBatch: position doesn't match the BatchPlayout");
+			}
+		}
+
+		// games are handed out position by position, numPlayouts each
+		size_t nextPosition = 0;
+		uint32_t playoutsLeft = numPlayouts;
+		const auto startGame = [&](Lanes& lanes, size_t lane)
+		{
+			for (; nextPosition < numPositions; ++nextPosition, playoutsLeft = numPlayouts)
+			{
+				const FourAcross& position = positions[nextPosition];
+				PlayoutCounts& positionCounts = counts[nextPosition];
+				if (playoutsLeft == numPlayouts)
+				{
+					positionCounts = PlayoutCounts{};
+					if (position.hasWinner() || position.boardFull())
+					{
+						// the player to move lost, or nobody can move
+						(position.hasWinner() ? positionCounts.losses : positionCounts.draws) = numPlayouts;
+						continue;
+					}
+				}
+				if (playoutsLeft == 0)
+				{
+					continue;
+				}
+
+				--playoutsLeft;
+				const Board& board = position.getBoard();
+				const uint8_t player = position.getCurrentPlayer();
+				uint64_t occupied = 0;
+				uint64_t pieces = 0;
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					for (uint8_t row = 0; row < board.getColumnHeightUnchecked(column); ++row)
+					{
+						const uint64_t cell = uint64_t{1} << (column * numRows + row);
+						occupied |= cell;
+						pieces |= board.getDiskOwnerAtUnchecked(column, row) == player ? cell : 0;
+					}
+				}
+				lanes.occupied[lane] = occupied;
+				lanes.pieces[lane] = pieces;
+				lanes.otherPieces[lane] = occupied & ~pieces;
+				lanes.positions[lane] = nextPosition;
+				lanes.isSwapped[lane] = false;
+				return;
+			}
+
+			lanes.occupied[lane] = fullMask;
+			lanes.pieces[lane] = 0;
+			lanes.otherPieces[lane] = 0;
+			lanes.positions[lane] = noPosition;
+		};
+
+		Lanes lanes;
+		size_t numActive = 0;
+		for (size_t lane = 0; lane < numLanes; ++lane)
+		{
+			// xorshift must not start at 0
+			lanes.rngStates[lane] = rng() | 1;
+			startGame(lanes, lane);
+			numActive += lanes.positions[lane] != noPosition;
+		}
+
+		while (numActive != 0)
+		{
+			makeRandomMoves(lanes);
+			findLines(lanes);
+
+			for (size_t lane = 0; lane < numLanes; ++lane)
+			{
+				if (lanes.moves[lane] == 0)
+				{
+					continue;
+				}
+
+				const bool isWin = lanes.lines[lane] != 0;
+				if (!isWin && lanes.occupied[lane] != fullMask)
+				{
+					std::swap(lanes.pieces[lane], lanes.otherPieces[lane]);
+					lanes.isSwapped[lane] = !lanes.isSwapped[lane];
+					continue;
+				}
+
+				PlayoutCounts& positionCounts = counts[lanes.positions[lane]];
+				if (isWin)
+				{
+					// the player who just moved won
+					++(lanes.isSwapped[lane] ? positionCounts.losses : positionCounts.wins);
+				}
+				else
+				{
+					++positionCounts.draws;
+				}
+				startGame(lanes, lane);
+				numActive -= lanes.positions[lane] == noPosition;
+			}
+		}
+	}
+
+	void BatchPlayout::makeRandomMoves(Lanes& lanes) const noexcept
+	{
+		// a column is full when its top cell is; dropping a piece in column c adds the bottom cell of
+		// c to the column's pieces, which carries up to the first empty cell
+		size_t lane = 0;
+#if defined(__AVX2__)
+		{
+			const __m256i numColumnsLane = _mm256_set1_epi64x(numColumns);
+			const __m256i numRowsLane = _mm256_set1_epi64x(numRows);
+			const __m256i columnLane = _mm256_set1_epi64x(static_cast<long long>(columnBits));
+			const __m256i topLane = _mm256_set1_epi64x(static_cast<long long>(uint64_t{1} << (numRows - 1)));
+			const __m256i one = _mm256_set1_epi64x(1);
+			const __m256i zero = _mm256_setzero_si256();
+			for (; lane + 4 <= numLanes; lane += 4)
+			{
+				__m256i state = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.rngStates + lane));
+				state = _mm256_xor_si256(state, _mm256_slli_epi64(state, 13));
+				state = _mm256_xor_si256(state, _mm256_srli_epi64(state, 7));
+				state = _mm256_xor_si256(state, _mm256_slli_epi64(state, 17));
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.rngStates + lane), state);
+
+				// the low 32 random bits times numColumns, over 2^32
+				const __m256i column = _mm256_srli_epi64(_mm256_mul_epu32(state, numColumnsLane), 32);
+				const __m256i shift = _mm256_mul_epu32(column, numRowsLane);
+
+				const __m256i occupied = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.occupied + lane));
+				const __m256i hasRoom = _mm256_cmpeq_epi64(_mm256_and_si256(occupied, _mm256_sllv_epi64(topLane, shift)), zero);
+				const __m256i dropped = _mm256_and_si256(
+					_mm256_add_epi64(occupied, _mm256_sllv_epi64(one, shift)), _mm256_sllv_epi64(columnLane, shift));
+				const __m256i move = _mm256_and_si256(dropped, hasRoom);
+
+				const __m256i pieces = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.pieces + lane));
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.moves + lane), move);
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.occupied + lane), _mm256_or_si256(occupied, move));
+				_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.pieces + lane), _mm256_or_si256(pieces, move));
+			}
+		}
+#endif
+		for (; lane < numLanes; ++lane)
+		{
+			const uint64_t random = nextRandom(lanes.rngStates[lane]);
+			const uint64_t column = (random & 0xffffffff) * numColumns >> 32;
+			const uint64_t shift = column * numRows;
+			const uint64_t occupied = lanes.occupied[lane];
+			const bool isFull = (occupied >> shift) & (uint64_t{1} << (numRows - 1));
+			const uint64_t move = isFull ? 0 : (occupied + (uint64_t{1} << shift)) & (columnBits << shift);
+			lanes.moves[lane] = move;
+			lanes.occupied[lane] = occupied | move;
+			lanes.pieces[lane] |= move;
+		}
+	}
+
+	void BatchPlayout::findLines(Lanes& lanes) const noexcept
+	{
+		size_t lane = 0;
+#if defined(__AVX2__)
+		for (; lane + 4 <= numLanes; lane += 4)
+		{
+			const __m256i pieces = _mm256_load_si256(reinterpret_cast<const __m256i*>(lanes.pieces + lane));
+			__m256i lines = _mm256_setzero_si256();
+			for (uint8_t direction = 0; direction < 4; ++direction)
+			{
+				const __m128i shift = _mm_cvtsi32_si128(shifts[direction]);
+				const __m256i neighbors = _mm256_set1_epi64x(static_cast<long long>(neighborMasks[direction]));
+				__m256i starts = _mm256_and_si256(_mm256_and_si256(pieces, _mm256_srl_epi64(pieces, shift)), neighbors);
+				for (uint8_t step = 0; step < numLineSteps; ++step)
+				{
+					const __m128i stepShift = _mm_cvtsi32_si128(lineSteps[step] * shifts[direction]);
+					starts = _mm256_and_si256(starts, _mm256_srl_epi64(starts, stepShift));
+				}
+				lines = _mm256_or_si256(lines, starts);
+			}
+			_mm256_store_si256(reinterpret_cast<__m256i*>(lanes.lines + lane), lines);
+		}
+#endif
+#if defined(__SSE2__)
+		for (; lane + 2 <= numLanes; lane += 2)
+		{
+			const __m128i pieces = _mm_load_si128(reinterpret_cast<const __m128i*>(lanes.pieces + lane));
+			__m128i lines = _mm_setzero_si128();
+			for (uint8_t direction = 0; direction < 4; ++direction)
+			{
+				const __m128i shift = _mm_cvtsi32_si128(shifts[direction]);
+				const __m128i neighbors = _mm_set1_epi64x(static_cast<long long>(neighborMasks[direction]));
+				__m128i starts = _mm_and_si128(_mm_and_si128(pieces, _mm_srl_epi64(pieces, shift)), neighbors);
+				for (uint8_t step = 0; step < numLineSteps; ++step)
+				{
+					const __m128i stepShift = _mm_cvtsi32_si128(lineSteps[step] * shifts[direction]);
+					starts = _mm_and_si128(starts, _mm_srl_epi64(starts, stepShift));
+				}
+				lines = _mm_or_si128(lines, starts);
+			}
+			_mm_store_si128(reinterpret_cast<__m128i*>(lanes.lines + lane), lines);
+		}
+#endif
+		for (; lane < numLanes; ++lane)
+		{
+			lanes.lines[lane] = findLines(lanes.pieces[lane]);
+		}
+	}
+
+	uint64_t BatchPlayout::findLines(uint64_t pieces) const noexcept
+	{
+		uint64_t lines = 0;
+		for (uint8_t direction = 0; direction < 4; ++direction)
+		{
+			uint64_t starts = pieces & (pieces >> shifts[direction]) & neighborMasks[direction];
+			for (uint8_t step = 0; step < numLineSteps; ++step)
+			{
+				starts &= starts >> (lineSteps[step] * shifts[direction]);
+			}
+			lines |= starts;
+		}
+		return lines;
+	}
+}
@@ -1,5 +1,9 @@
 #include "four-across/game/board.hpp"
+#include "four-across/game/fixedboard.hpp"
+#include "four-across/game/widebitboard.hpp"
+#include "four-across/game/zobrist.hpp"
 
+#include <algorithm>
 #include <exception>
 #include <iostream>
 #include <iomanip>
@@ -7,29 +11,157 @@
 
 namespace game
 {
-	Board::Board(uint8_t numColumns, uint8_t numRows) : numColumns{numColumns}, numRows{numRows}
+	namespace
 	{
-		if (numColumns < minColumns || numRows < minRows || numColumns - numRows < 1)
+		// Line checks are written once for single word and wide bitboards.
+		inline uint64_t shiftedRight(uint64_t bits, size_t count) noexcept
 		{
-			throw std::invalid_argument("Board::Board: invalid board dimensions");
+			return bits >> count;
+		}
+
+		template<size_t Words>
+		inline WideBitboard<Words> shiftedRight(const WideBitboard<Words>& bits, size_t count) noexcept
+		{
+			return bits.shiftedRight(count);
+		}
+
+		inline bool isAnySet(uint64_t bits) noexcept
+		{
+			return bits != 0;
+		}
+
+		template<size_t Words>
+		inline bool isAnySet(const WideBitboard<Words>& bits) noexcept
+		{
+			return bits.any();
+		}
+
+		// pairs has a bit set for each piece whose next cell in the direction is also the player's.
+		// Returns the first cell of every line of Length pieces: Length - 1 consecutive pairs.
+		template<uint8_t Length, typename Bits>
+		inline Bits findLineStarts(const Bits& pairs, uint8_t shift) noexcept
+		{
+			// the loop has a constant trip count, so each length gets its own unrolled chain of shifts
+			Bits starts{pairs};
+			for (uint8_t pair = 1; pair < Length - 1; ++pair)
+			{
+				starts &= shiftedRight(pairs, pair * shift);
+			}
+			return starts;
+		}
+
+		// Same as findLineStarts for any length.
+		template<typename Bits>
+		Bits findLineStarts(const Bits& pairs, uint8_t shift, uint8_t length) noexcept
+		{
+			// a line of n pieces overlapping one up to n - 1 cells further on makes a longer line,
+			// so the length found almost doubles each step
+			Bits starts{pairs};
+			uint8_t found = 2;
+			while (found < length)
+			{
+				const uint8_t step = std::min<uint8_t>(found - 1, length - found);
+				starts &= shiftedRight(starts, step * shift);
+				found += step;
+			}
+			return starts;
+		}
+
+		template<uint8_t Length, typename Bits>
+		bool containsLine(const Bits& pieces, const Bits* neighbors, const uint8_t* shifts) noexcept
+		{
+			Bits lines{};
+			for (uint8_t direction = 0; direction < 4; ++direction)
+			{
+				const Bits pairs = pieces & shiftedRight(pieces, shifts[direction]) & neighbors[direction];
+				lines |= findLineStarts<Length>(pairs, shifts[direction]);
+			}
+			return isAnySet(lines);
 		}
 
-		columns.resize(numColumns);
-		for (auto& column : columns)
+		template<typename Bits>
+		bool containsLine(const Bits& pieces, const Bits* neighbors, const uint8_t* shifts, uint8_t length) noexcept
 		{
-			column.resize(numRows);
+			switch (length)
+			{
+			case 3:
+				return containsLine<3>(pieces, neighbors, shifts);
+			case 4:
+				return containsLine<4>(pieces, neighbors, shifts);
+			case 5:
+				return containsLine<5>(pieces, neighbors, shifts);
+			case 6:
+				return containsLine<6>(pieces, neighbors, shifts);
+			default:
+				break;
+			}
+
+			Bits lines{};
+			for (uint8_t direction = 0; direction < 4; ++direction)
+			{
+				const Bits pairs = pieces & shiftedRight(pieces, shifts[direction]) & neighbors[direction];
+				lines |= findLineStarts(pairs, shifts[direction], length);
+			}
+			return isAnySet(lines);
+		}
+	}
+
+	constexpr uint8_t Board::emptySlot;
+	constexpr uint8_t Board::minColumns;
+	constexpr uint8_t Board::minRows;
+	constexpr uint8_t Board::maxBitboardCells;
+	constexpr uint16_t Board::maxWideBitboardCells;
+	constexpr uint8_t Board::maxBitboardPlayers;
+
+	Board::Board(uint8_t numColumns, uint8_t numRows) :
+		numColumns{numColumns},
+		numRows{numRows},
+		numPieces{0},
+		key{0},
+		mirroredKey{0},
+		useBitboard{false},
+		occupiedMask{0},
+		playerMasks{},
+		neighborMasks{},
+		fourInARowKernel{nullptr},
+		wideWords{0}
+	{
+		if (numColumns < minColumns || numRows < minRows || numColumns - numRows < 1)
+		{
+			throw std::invalid_argument("Board::Board: invalid board dimensions");
 		}
-		rowIndices.resize(numColumns);
+
+		grid.resize(numColumns * numRows + numColumns, emptySlot);
+
+		initBitboard();
 	}
 
+	Board::Board(const Board& board) = default;
+
+	Board& Board::operator=(const Board& board) = default;
+
 	Board::Board(Board && board) noexcept :
 		numColumns{board.numColumns},
 		numRows{board.numRows},
-		columns{std::move(board.columns)},
-		rowIndices{std::move(board.rowIndices)}
+		grid{std::move(board.grid)},
+		numPieces{board.numPieces},
+		key{board.key},
+		mirroredKey{board.mirroredKey},
+		useBitboard{board.useBitboard},
+		occupiedMask{board.occupiedMask},
+		playerMasks(board.playerMasks),
+		neighborMasks(board.neighborMasks),
+		fourInARowKernel{board.fourInARowKernel},
+		wideWords{board.wideWords},
+		wideMasks{std::move(board.wideMasks)}
 	{
 		board.numColumns = 0;
 		board.numRows = 0;
+		board.numPieces = 0;
+		board.key = 0;
+		board.mirroredKey = 0;
+		board.useBitboard = false;
+		board.wideWords = 0;
 	}
 
 	Board::~Board()
@@ -40,65 +172,229 @@ namespace game
 	{
 		numColumns = board.numColumns;
 		numRows = board.numRows;
+		numPieces = board.numPieces;
+		key = board.key;
+		mirroredKey = board.mirroredKey;
+
+		useBitboard = board.useBitboard;
+		occupiedMask = board.occupiedMask;
+		playerMasks = board.playerMasks;
+		neighborMasks = board.neighborMasks;
+		fourInARowKernel = board.fourInARowKernel;
+		wideWords = board.wideWords;
 
 		board.numColumns = 0;
 		board.numRows = 0;
+		board.numPieces = 0;
+		board.key = 0;
+		board.mirroredKey = 0;
+		board.useBitboard = false;
+		board.wideWords = 0;
 
-		columns = std::move(board.columns);
-		rowIndices = std::move(board.rowIndices);
+		grid = std::move(board.grid);
+		wideMasks = std::move(board.wideMasks);
 
 		return *this;
 	}
 
 	bool Board::isFull() const noexcept
 	{
-		bool isBoardFull = true;
-
-		for (uint8_t i = 0; i < numColumns; ++i)
+		if (useBitboard)
 		{
-			if (!isColumnFullInternal(i))
-			{
-				isBoardFull = false;
-				break;
-			}
+			const unsigned numCells = numColumns * numRows;
+			const bitboard_t fullMask = numCells == maxBitboardCells ? ~bitboard_t{0} : (bitboard_t{1} << numCells) - 1;
+			return occupiedMask == fullMask;
 		}
 
-		return isBoardFull;
+		return numPieces == numColumns * numRows;
 	}
 
 	bool Board::isColumnFull(uint8_t column) const
 	{
-		if (!isColumnInRange(column))
+		bool isColumnFull{false};
+		if (tryIsColumnFull(column, isColumnFull) == Status::outOfRange)
 		{
 			throw std::out_of_range("Board::isColumnFull: index out of range");
 		}
-		return isColumnFullInternal(column);
+		return isColumnFull;
 	}
 
 	bool Board::dropPieceInColumn(uint8_t column, uint8_t playerNum)
 	{
-		if (!isColumnInRange(column))
+		const Status status = tryDropPieceInColumn(column, playerNum);
+		if (status == Status::outOfRange)
 		{
 			throw std::out_of_range("Board::dropPieceInColumn: index out of range");
 		}
+		return status == Status::success;
+	}
+
+	bool Board::removePieceFromColumn(uint8_t column)
+	{
+		const Status status = tryRemovePieceFromColumn(column);
+		if (status == Status::outOfRange)
+		{
+			throw std::out_of_range("Board::removePieceFromColumn: index out of range");
+		}
+		return status == Status::success;
+	}
+
+	Board::Status Board::tryDropPieceInColumn(uint8_t column, uint8_t playerNum) noexcept
+	{
+		if (!isColumnInRange(column))
+		{
+			return Status::outOfRange;
+		}
 
 		if (isColumnFullInternal(column))
 		{
-			return false;
+			return Status::columnFull;
 		}
 
-		columns[column][rowIndices[column]++] = playerNum;
-		return true;
+		pushPiece(column, playerNum);
+		return Status::success;
 	}
 
-	uint8_t Board::getDiskOwnerAt(uint8_t column, uint8_t row) const
+	Board::Status Board::tryRemovePieceFromColumn(uint8_t column) noexcept
+	{
+		if (!isColumnInRange(column))
+		{
+			return Status::outOfRange;
+		}
+
+		if (heightOf(column) == 0)
+		{
+			return Status::columnEmpty;
+		}
+
+		popPiece(column);
+		return Status::success;
+	}
+
+	Board::Status Board::tryIsColumnFull(uint8_t column, bool& isColumnFull) const noexcept
+	{
+		if (!isColumnInRange(column))
+		{
+			return Status::outOfRange;
+		}
+
+		isColumnFull = isColumnFullInternal(column);
+		return Status::success;
+	}
+
+	Board::Status Board::tryGetDiskOwnerAt(uint8_t column, uint8_t row, uint8_t& owner) const noexcept
 	{
 		if (!isColumnInRange(column) || !isRowInRange(row))
 		{
-			throw std::out_of_range("Board::getPieceOwnerAt: index out of range");
+			return Status::outOfRange;
 		}
 
-		return columns[column][row];
+		owner = getDiskOwnerAtUnchecked(column, row);
+		return Status::success;
+	}
+
+	Board::Status Board::tryGetColumnHeight(uint8_t column, uint8_t& height) const noexcept
+	{
+		if (!isColumnInRange(column))
+		{
+			return Status::outOfRange;
+		}
+
+		height = heightOf(column);
+		return Status::success;
+	}
+
+	void Board::pushPiece(uint8_t column, uint8_t playerNum) noexcept
+	{
+		if (hasBitboard() && (playerNum == emptySlot || playerNum > maxBitboardPlayers))
+		{
+			// player can't be tracked, the grid is still up to date so fall back to it
+			useBitboard = false;
+			wideWords = 0;
+		}
+
+		if (useBitboard)
+		{
+			// adding the bottom bit carries up to the first empty cell in the column
+			const bitboard_t columnMask = getColumnMask(column);
+			const bitboard_t piece = ((occupiedMask & columnMask) + getCellBit(column, 0)) & columnMask;
+			occupiedMask |= piece;
+			playerMasks[playerNum - 1] |= piece;
+		}
+		else if (wideWords != 0)
+		{
+			const size_t cell = column * numRows + heightOf(column);
+			const uint64_t piece = uint64_t{1} << (cell % 64);
+			getWideMask(0)[cell / 64] |= piece;
+			getWideMask(playerNum)[cell / 64] |= piece;
+		}
+
+		key ^= zobrist::getPieceKey(column * numRows + heightOf(column), playerNum);
+		mirroredKey ^= zobrist::getPieceKey(getMirroredColumn(column) * numRows + heightOf(column), playerNum);
+		cellAt(column, heightOf(column)++) = playerNum;
+		++numPieces;
+	}
+
+	void Board::popPiece(uint8_t column) noexcept
+	{
+		const uint8_t row = --heightOf(column);
+		const uint8_t playerNum = cellAt(column, row);
+		cellAt(column, row) = emptySlot;
+		--numPieces;
+		key ^= zobrist::getPieceKey(column * numRows + row, playerNum);
+		mirroredKey ^= zobrist::getPieceKey(getMirroredColumn(column) * numRows + row, playerNum);
+
+		// bitboards are only still in use if every piece, including this one, belongs to a tracked player
+		if (useBitboard)
+		{
+			const bitboard_t piece = getCellBit(column, row);
+			occupiedMask &= ~piece;
+			playerMasks[playerNum - 1] &= ~piece;
+		}
+		else if (wideWords != 0)
+		{
+			const size_t cell = column * numRows + row;
+			const uint64_t piece = uint64_t{1} << (cell % 64);
+			getWideMask(0)[cell / 64] &= ~piece;
+			getWideMask(playerNum)[cell / 64] &= ~piece;
+		}
+	}
+
+	void Board::copyCellsTo(uint8_t* cells) const noexcept
+	{
+		std::copy(grid.begin(), grid.begin() + numColumns * numRows, cells);
+	}
+
+	void Board::assignCells(const uint8_t* cells) noexcept
+	{
+		// start from an empty board with bitboards back on, then stack each column's pieces
+		std::fill(grid.begin(), grid.end(), emptySlot);
+		numPieces = 0;
+		key = 0;
+		mirroredKey = 0;
+		useBitboard = numColumns * numRows <= maxBitboardCells;
+		occupiedMask = 0;
+		playerMasks.fill(0);
+		wideWords = wideMasks.empty() ? 0 : getNumWideWords(numColumns * numRows);
+		std::fill(wideMasks.begin(), wideMasks.begin() + (1 + maxBitboardPlayers) * wideWords, uint64_t{0});
+
+		for (uint8_t column = 0; column < numColumns; ++column)
+		{
+			for (uint8_t row = 0; row < numRows && cells[column * numRows + row] != emptySlot; ++row)
+			{
+				pushPiece(column, cells[column * numRows + row]);
+			}
+		}
+	}
+
+	uint8_t Board::getDiskOwnerAt(uint8_t column, uint8_t row) const
+	{
+		uint8_t owner{emptySlot};
+		if (tryGetDiskOwnerAt(column, row, owner) == Status::outOfRange)
+		{
+			throw std::out_of_range("Board::getPieceOwnerAt: index out of range");
+		}
+		return owner;
 	}
 
 	Board::column_view_t Board::getColumn(uint8_t column) const
@@ -107,16 +403,17 @@ namespace game
 		{
 			throw std::out_of_range("Board::getColumn: index out of range");
 		}
-		return ColumnView{columns[column]};
+		return getColumnUnchecked(column);
 	}
 
 	uint8_t game::Board::getColumnHeight(uint8_t column) const
 	{
-		if (!isColumnInRange(column))
+		uint8_t height{0};
+		if (tryGetColumnHeight(column, height) == Status::outOfRange)
 		{
 			throw std::out_of_range("Board::getColumn: index out of range");
 		}
-		return rowIndices[column];
+		return height;
 	}
 
 	Board::column_value_t  Board::getRow(uint8_t row) const
@@ -125,13 +422,81 @@ namespace game
 		{
 			throw std::out_of_range("Board::getRow: index out of range");
 		}
+		return getRowUnchecked(row);
+	}
 
-		std::vector<uint8_t> boardRow;
-		for (const auto& column : columns)
+	Board::line_view_t Board::getDiagonal(uint8_t column, uint8_t row) const
+	{
+		if (!isColumnInRange(column) || !isRowInRange(row))
 		{
-			boardRow.push_back(column[row]);
+			throw std::out_of_range("Board::getDiagonal: index out of range");
 		}
-		return Column{std::move(boardRow)};
+		return getDiagonalUnchecked(column, row);
+	}
+
+	Board::line_view_t Board::getAntiDiagonal(uint8_t column, uint8_t row) const
+	{
+		if (!isColumnInRange(column) || !isRowInRange(row))
+		{
+			throw std::out_of_range("Board::getAntiDiagonal: index out of range");
+		}
+		return getAntiDiagonalUnchecked(column, row);
+	}
+
+	Board::column_view_t Board::getColumnUnchecked(uint8_t column) const noexcept
+	{
+		return LineView{&cellAt(column, 0), 1, numRows};
+	}
+
+	Board::column_value_t Board::getRowUnchecked(uint8_t row) const noexcept
+	{
+		return LineView{&cellAt(0, row), numRows, numColumns};
+	}
+
+	Board::line_view_t Board::getDiagonalUnchecked(uint8_t column, uint8_t row) const noexcept
+	{
+		// walk down and to the left to the edge of the board
+		const uint8_t stepsToEdge = std::min(column, row);
+		const uint8_t firstColumn = column - stepsToEdge;
+		const uint8_t firstRow = row - stepsToEdge;
+		const uint8_t length = std::min(numColumns - firstColumn, numRows - firstRow);
+		return LineView{&cellAt(firstColumn, firstRow), numRows + 1u, length};
+	}
+
+	Board::line_view_t Board::getAntiDiagonalUnchecked(uint8_t column, uint8_t row) const noexcept
+	{
+		// walk up and to the left to the edge of the board
+		const uint8_t stepsToEdge = std::min<uint8_t>(column, numRows - 1 - row);
+		const uint8_t firstColumn = column - stepsToEdge;
+		const uint8_t firstRow = row + stepsToEdge;
+		const uint8_t length = std::min(numColumns - firstColumn, firstRow + 1);
+		return LineView{&cellAt(firstColumn, firstRow), numRows - 1u, length};
+	}
+
+	bool Board::hasLineOfLength(uint8_t playerNum, uint8_t length) const noexcept
+	{
+		switch (wideWords)
+		{
+		case 2:
+			return containsWideLine<2>(playerNum, length);
+		case 4:
+			return containsWideLine<4>(playerNum, length);
+		case 8:
+			return containsWideLine<8>(playerNum, length);
+		default:
+			break;
+		}
+
+		const bitboard_t pieces = playerMasks[playerNum - 1];
+		if (length == 4 && fourInARowKernel)
+		{
+			return fourInARowKernel(pieces);
+		}
+
+		const uint8_t shifts[numDirections]{
+			getDirectionShift(vertical), getDirectionShift(horizontal),
+			getDirectionShift(diagonal), getDirectionShift(antiDiagonal)};
+		return containsLine(pieces, neighborMasks.data(), shifts, length);
 	}
 
 	game::Board::operator std::string() const
@@ -164,59 +529,181 @@ namespace game
 		return strStream.str();
 	}
 
-	inline bool Board::isColumnFullInternal(uint8_t column) const noexcept
+	void Board::initBitboard()
 	{
-		return rowIndices[column] == numRows;
+		const uint16_t numCells = numColumns * numRows;
+		useBitboard = numCells <= maxBitboardCells;
+		if (!useBitboard)
+		{
+			initWideBitboard(numCells);
+			return;
+		}
+
+		for (uint8_t col = 0; col < numColumns; ++col)
+		{
+			for (uint8_t row = 0; row < numRows; ++row)
+			{
+				const bitboard_t cell = getCellBit(col, row);
+				const bool hasAbove = row < numRows - 1;
+				const bool hasBelow = row > 0;
+				const bool hasRight = col < numColumns - 1;
+				neighborMasks[vertical] |= hasAbove ? cell : 0;
+				neighborMasks[horizontal] |= hasRight ? cell : 0;
+				neighborMasks[diagonal] |= hasAbove && hasRight ? cell : 0;
+				neighborMasks[antiDiagonal] |= hasBelow && hasRight ? cell : 0;
+			}
+		}
+
+		// the common sizes use the FixedBoard check, where the shifts and masks are constants
+		fourInARowKernel = detail::dispatchBoardSize(numColumns, numRows, detail::fixed_board_sizes_t{},
+			[]() -> win_kernel_t
+			{
+				return nullptr;
+			},
+			[](auto size) -> win_kernel_t
+			{
+				using dimensions_t = decltype(size);
+				return &FixedBoard<dimensions_t::numColumns, dimensions_t::numRows>::containsFourInARow;
+			});
 	}
 
-	inline bool Board::isColumnInRange(uint8_t column) const noexcept
+	void Board::initWideBitboard(uint16_t numCells)
 	{
-		return column >= 0 && column < numColumns;
+		wideWords = getNumWideWords(numCells);
+		if (wideWords == 0)
+		{
+			return;
+		}
+
+		wideMasks.resize((1 + maxBitboardPlayers + numDirections) * wideWords);
+
+		uint64_t* const neighbors = getWideMask(1 + maxBitboardPlayers);
+		for (uint8_t col = 0; col < numColumns; ++col)
+		{
+			for (uint8_t row = 0; row < numRows; ++row)
+			{
+				const size_t cell = col * numRows + row;
+				const uint64_t piece = uint64_t{1} << (cell % 64);
+				const bool hasAbove = row < numRows - 1;
+				const bool hasBelow = row > 0;
+				const bool hasRight = col < numColumns - 1;
+				neighbors[vertical * wideWords + cell / 64] |= hasAbove ? piece : 0;
+				neighbors[horizontal * wideWords + cell / 64] |= hasRight ? piece : 0;
+				neighbors[diagonal * wideWords + cell / 64] |= hasAbove && hasRight ? piece : 0;
+				neighbors[antiDiagonal * wideWords + cell / 64] |= hasBelow && hasRight ? piece : 0;
+			}
+		}
 	}
 
-	inline bool Board::isRowInRange(uint8_t row) const noexcept
+	uint8_t Board::getNumWideWords(uint16_t numCells) noexcept
 	{
-		return row >= 0 && row < numRows;
+		if (numCells > maxWideBitboardCells)
+		{
+			return 0;
+		}
+
+		// use the narrowest SIMD width that holds the board
+		return numCells <= 128 ? 2 : numCells <= 256 ? 4 : 8;
 	}
 
-	Board::ColumnView::ColumnView(const Board::column_t& column) : column{column}
+	template<size_t Words>
+	bool Board::containsWideLine(uint8_t playerNum, uint8_t length) const noexcept
 	{
+		using wide_bitboard_t = WideBitboard<Words>;
+		const auto pieces = wide_bitboard_t::load(getWideMask(playerNum));
+
+		const uint64_t* const neighborWords = getWideMask(1 + maxBitboardPlayers);
+		wide_bitboard_t neighbors[numDirections];
+		uint8_t shifts[numDirections];
+		for (uint8_t direction = 0; direction < numDirections; ++direction)
+		{
+			neighbors[direction] = wide_bitboard_t::load(neighborWords + direction * Words);
+			shifts[direction] = getDirectionShift(static_cast<Direction>(direction));
+		}
+
+		// same as the single word check, on all words at once
+		return containsLine(pieces, neighbors, shifts, length);
 	}
 
-	Board::column_t::const_iterator Board::ColumnView::begin() const noexcept
+	inline uint64_t* Board::getWideMask(uint8_t index) noexcept
 	{
-		return column.begin();
+		return wideMasks.data() + index * wideWords;
 	}
 
-	Board::column_t::const_iterator Board::ColumnView::end() const noexcept
+	inline const uint64_t* Board::getWideMask(uint8_t index) const noexcept
 	{
-		return column.end();
+		return wideMasks.data() + index * wideWords;
 	}
 
-	Board::column_t::value_type game::Board::ColumnView::operator[](uint8_t index) const
+	inline Board::bitboard_t Board::getCellBit(uint8_t column, uint8_t row) const noexcept
 	{
-		return column[index];
+		return bitboard_t{1} << (column * numRows + row);
 	}
 
-	Board::Column::Column(Board::column_t && column) : column{column}
+	inline Board::bitboard_t Board::getColumnMask(uint8_t column) const noexcept
 	{
+		return ((bitboard_t{1} << numRows) - 1) << (column * numRows);
 	}
 
+	inline uint8_t Board::getDirectionShift(Direction direction) const noexcept
+	{
+		switch (direction)
+		{
+		case vertical:
+			return 1; // next row up
+		case horizontal:
+			return numRows; // next column over
+		case diagonal:
+			return numRows + 1; // up and to the right
+		default:
+			return numRows - 1; // down and to the right
+		}
+	}
 
-	Board::column_t::const_iterator Board::Column::begin() const noexcept
+	uint8_t Board::getDiskOwnerAtUnchecked(uint8_t column, uint8_t row) const noexcept
 	{
-		return column.begin();
+		if (useBitboard)
+		{
+			const bitboard_t cell = getCellBit(column, row);
+			for (uint8_t player = 0; player < maxBitboardPlayers; ++player)
+			{
+				if (playerMasks[player] & cell)
+				{
+					return player + 1;
+				}
+			}
+			return emptySlot;
+		}
+
+		if (wideWords != 0)
+		{
+			const size_t cell = column * numRows + row;
+			const uint64_t piece = uint64_t{1} << (cell % 64);
+			for (uint8_t player = 1; player <= maxBitboardPlayers; ++player)
+			{
+				if (getWideMask(player)[cell / 64] & piece)
+				{
+					return player;
+				}
+			}
+			return emptySlot;
+		}
+
+		return cellAt(column, row);
 	}
 
-	Board::column_t::const_iterator Board::Column::end() const noexcept
+	inline bool Board::isColumnFullInternal(uint8_t column) const noexcept
 	{
-		return column.end();
+		return heightOf(column) == numRows;
 	}
 
-	Board::column_t::value_type game::Board::Column::operator[](uint8_t index) const
+	inline bool Board::isColumnInRange(uint8_t column) const noexcept
 	{
-		return column[index];
+		return column >= 0 && column < numColumns;
 	}
 
+	inline bool Board::isRowInRange(uint8_t row) const noexcept
+	{
+		return row >= 0 && row < numRows;
+	}
 }
-
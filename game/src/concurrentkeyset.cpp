@@ -0,0 +1,105 @@
+#include "four-across/game/concurrentkeyset.hpp"
+
+namespace game
+{
+	ConcurrentKeySet::ConcurrentKeySet(size_t capacity) :
+		slotMask{0},
+		capacity{capacity},
+		numKeys{0},
+		hasZeroKey{false}
+	{
+		size_t numSlots = 1;
+		while (numSlots < 2 * capacity)
+		{
+			numSlots *= 2;
+		}
+		slotMask = numSlots - 1;
+		slots.reset(new std::atomic<uint64_t>[numSlots]);
+		clear();
+	}
+
+	ConcurrentKeySet::InsertResult ConcurrentKeySet::insert(uint64_t key) noexcept
+	{
+		if (key == 0)
+		{
+			if (hasZeroKey.load(std::memory_order_relaxed))
+			{
+				return InsertResult::alreadyPresent;
+			}
+			if (numKeys.fetch_add(1, std::memory_order_relaxed) >= capacity)
+			{
+				numKeys.fetch_sub(1, std::memory_order_relaxed);
+				return InsertResult::full;
+			}
+			if (hasZeroKey.exchange(true, std::memory_order_relaxed))
+			{
+				numKeys.fetch_sub(1, std::memory_order_relaxed);
+				return InsertResult::alreadyPresent;
+			}
+			return InsertResult::inserted;
+		}
+
+		for (size_t i = 0, slot = key & slotMask; i <= slotMask; ++i, slot = (slot + 1) & slotMask)
+		{
+			uint64_t found = slots[slot].load(std::memory_order_relaxed);
+			if (found == key)
+			{
+				return InsertResult::alreadyPresent;
+			}
+			if (found != 0)
+			{
+				continue;
+			}
+
+			// reserve room for the key before claiming the slot, so the set never goes over capacity
+			if (numKeys.fetch_add(1, std::memory_order_relaxed) >= capacity)
+			{
+				numKeys.fetch_sub(1, std::memory_order_relaxed);
+				return InsertResult::full;
+			}
+			if (slots[slot].compare_exchange_strong(found, key, std::memory_order_relaxed))
+			{
+				return InsertResult::inserted;
+			}
+			numKeys.fetch_sub(1, std::memory_order_relaxed);
+			if (found == key)
+			{
+				// another thread added the same key first
+				return InsertResult::alreadyPresent;
+			}
+		}
+		return InsertResult::full;
+	}
+
+	bool ConcurrentKeySet::contains(uint64_t key) const noexcept
+	{
+		if (key == 0)
+		{
+			return hasZeroKey.load(std::memory_order_relaxed);
+		}
+
+		for (size_t i = 0, slot = key & slotMask; i <= slotMask; ++i, slot = (slot + 1) & slotMask)
+		{
+			const uint64_t found = slots[slot].load(std::memory_order_relaxed);
+			if (found == key)
+			{
+				return true;
+			}
+			if (found == 0)
+			{
+				return false;
+			}
+		}
+		return false;
+	}
+
+	void ConcurrentKeySet::clear() noexcept
+	{
+		for (size_t slot = 0; slot <= slotMask; ++slot)
+		{
+			slots[slot].store(0, std::memory_order_relaxed);
+		}
+		numKeys.store(0, std::memory_order_relaxed);
+		hasZeroKey.store(false, std::memory_order_relaxed);
+	}
+}
@@ -1,25 +1,141 @@
 #include "four-across/game/game.hpp"
 
-#include "logging.hpp"
-
+#include <algorithm>
 #include <exception>
 #include <iostream>
+#include <limits>
 #include <sstream>
+#include <stdexcept>
 
 namespace game
 {
+	constexpr uint16_t GameSnapshot::maxCells;
+
+	constexpr uint8_t FourAcross::noWinner;
+	constexpr uint8_t FourAcross::defaultFirstPlayer;
+	constexpr uint8_t FourAcross::minNumPlayers;
+	constexpr uint8_t FourAcross::minWinLength;
+	constexpr uint8_t FourAcross::defaultWinLength;
+	const FourAcross::WinDetection FourAcross::defaultWinDetection{FourAcross::WinDetection::automatic};
+
+	namespace
+	{
+		bool isPlayerInRange(uint8_t player, uint8_t numPlayers) noexcept
+		{
+			return player != Board::emptySlot && player <= numPlayers;
+		}
+
+		// Returns true if the snapshot describes a game that restore can load and later undo: the
+		// settings and players are in range, and the moves stack up to exactly the pieces in cells.
+		bool isValidSnapshot(const GameSnapshot& snapshot) noexcept
+		{
+			const uint8_t numColumns = snapshot.numColumns;
+			const uint8_t numRows = snapshot.numRows;
+			const uint16_t numCells = numColumns * numRows;
+			if (numCells > GameSnapshot::maxCells || snapshot.numTurns > numCells ||
+				snapshot.winDetection > static_cast<uint8_t>(FourAcross::WinDetection::incremental) ||
+				snapshot.numPlayers < FourAcross::minNumPlayers ||
+				!isPlayerInRange(snapshot.currentPlayer, snapshot.numPlayers) ||
+				(snapshot.winner != FourAcross::noWinner && !isPlayerInRange(snapshot.winner, snapshot.numPlayers)))
+			{
+				return false;
+			}
+
+			// count the pieces each column gets from the moves; a column can't hold more than 255
+			uint8_t heights[std::numeric_limits<uint8_t>::max() + 1]{};
+			for (uint32_t turn = 0; turn < snapshot.numTurns; ++turn)
+			{
+				const uint8_t column = snapshot.moves[turn];
+				if (column >= numColumns || heights[column] == numRows)
+				{
+					return false;
+				}
+				++heights[column];
+			}
+
+			// each column must hold exactly those pieces, from the bottom up and owned by players in the game
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				const uint8_t* const cells = snapshot.cells + column * numRows;
+				for (uint8_t row = 0; row < numRows; ++row)
+				{
+					const bool isPiece = row < heights[column];
+					if (isPiece ? !isPlayerInRange(cells[row], snapshot.numPlayers) : cells[row] != Board::emptySlot)
+					{
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+	}
+
 	FourAcross::FourAcross(
 		uint8_t numPlayers,
 		uint8_t firstPlayer,
 		uint8_t numColumns,
-		uint8_t numRows) :
+		uint8_t numRows,
+		uint8_t winLength,
+		WinDetection winDetection) :
 		numTurns{0},
 		numPlayers{numPlayers >= minNumPlayers ? numPlayers : minNumPlayers},
 		currentPlayer{firstPlayer > defaultFirstPlayer && firstPlayer <= numPlayers ? firstPlayer : defaultFirstPlayer},
 		lastMove{0, 0},
 		winner{noWinner},
+		winLength{winLength},
+		winDetection{winDetection},
 		board{numColumns, numRows}
 	{
+		if (winLength < minWinLength || winLength > numColumns)
+		{
+			throw std::invalid_argument("FourAcross::FourAcross: invalid win length");
+		}
+
+		if (winDetection == WinDetection::incremental)
+		{
+			lineCounters = LineCounters{numColumns, numRows};
+		}
+
+		moveHistory.reserve(numColumns * numRows);
+	}
+
+	FourAcross::FourAcross(const GameSnapshot& snapshot) :
+		FourAcross{snapshot.numPlayers, snapshot.currentPlayer, snapshot.numColumns, snapshot.numRows,
+			snapshot.winLength, static_cast<WinDetection>(snapshot.winDetection)}
+	{
+		restore(snapshot);
+	}
+
+	FourAcross::FourAcross(const FourAcross& connect) :
+		numTurns{connect.numTurns},
+		numPlayers{connect.numPlayers},
+		currentPlayer{connect.currentPlayer},
+		lastMove{connect.lastMove},
+		winner{connect.winner},
+		winLength{connect.winLength},
+		winDetection{connect.winDetection},
+		board{connect.board},
+		lineCounters{connect.lineCounters}
+	{
+		// copy into reserved storage, as the constructor does, so moves don't allocate
+		moveHistory.reserve(connect.getNumColumns() * connect.getNumRows());
+		moveHistory = connect.moveHistory;
+	}
+
+	FourAcross& FourAcross::operator=(const FourAcross& connect)
+	{
+		board = connect.board;
+		lineCounters = connect.lineCounters;
+		moveHistory.reserve(connect.getNumColumns() * connect.getNumRows());
+		moveHistory = connect.moveHistory;
+		winLength = connect.winLength;
+		winDetection = connect.winDetection;
+		numTurns = connect.numTurns;
+		numPlayers = connect.numPlayers;
+		lastMove = connect.lastMove;
+		winner = connect.winner;
+		currentPlayer = connect.currentPlayer;
+		return *this;
 	}
 
 	FourAcross::FourAcross(FourAcross && connect) noexcept :
@@ -28,7 +144,11 @@ namespace game
 		currentPlayer{connect.currentPlayer},
 		lastMove{std::move(connect.lastMove)},
 		winner{connect.winner},
-		board{std::move(connect.board)}
+		winLength{connect.winLength},
+		winDetection{connect.winDetection},
+		board{std::move(connect.board)},
+		lineCounters{std::move(connect.lineCounters)},
+		moveHistory{std::move(connect.moveHistory)}
 	{
 		connect.numTurns = 0;
 		connect.numPlayers = 0;
@@ -42,7 +162,7 @@ namespace game
 	{
 	}
 
-	FourAcross::TurnResult FourAcross::takeTurn(uint8_t player, uint8_t column)
+	FourAcross::TurnResult FourAcross::takeTurn(uint8_t player, uint8_t column) noexcept
 	{
 		if (winner != noWinner)
 		{
@@ -54,40 +174,133 @@ namespace game
 			return TurnResult::wrongPlayer;
 		}
 
-		try
+		switch (board.tryDropPieceInColumn(column, player))
 		{
-			bool dropSuccessful = board.dropPieceInColumn(column, player);
-			if (!dropSuccessful)
-			{
-				return TurnResult::columnFull;
-			}
-			else
-			{
-				// turn was valid
-				currentPlayer = getNextPlayer();
-				lastMove = std::make_pair<>(column, board.getColumnHeight(column) - 1);
-				++numTurns;
-				winner = checkForWinner();
-			}
+		case Board::Status::success:
+			// turn was valid
+			finishMove(column);
+			return TurnResult::success;
+		case Board::Status::columnFull:
+			return TurnResult::columnFull;
+		case Board::Status::outOfRange:
+			return TurnResult::badColumn;
+		default:
+			return TurnResult::error;
 		}
-		catch (std::out_of_range& error)
+	}
+
+	bool FourAcross::undoTurn()
+	{
+		if (moveHistory.empty())
 		{
-			// invalid column number 
-			printDebug("FourAcross::takeTurn: error taking turn:", error.what(), "\n");
-			return TurnResult::badColumn;
+			return false;
+		}
+
+		unmakeMove();
+		return true;
+	}
+
+	void FourAcross::makeMove(uint8_t column) noexcept
+	{
+		board.pushPiece(column, currentPlayer);
+		finishMove(column);
+	}
+
+	void FourAcross::unmakeMove() noexcept
+	{
+		const uint8_t column = moveHistory.back();
+		moveHistory.pop_back();
+
+		// the piece being taken back belongs to the player whose turn it was
+		currentPlayer = board.getDiskOwnerAtUnchecked(column, board.getColumnHeightUnchecked(column) - 1);
+		if (lineCounters.isEnabled())
+		{
+			lineCounters.removePiece(lastMove.first, lastMove.second);
+		}
+		board.popPiece(column);
+		--numTurns;
+
+		// no moves can be taken after a win, so there wasn't a winner before this one
+		winner = noWinner;
+		if (moveHistory.empty())
+		{
+			lastMove = {0, 0};
+		}
+		else
+		{
+			const uint8_t previousColumn = moveHistory.back();
+			lastMove = std::make_pair<>(previousColumn, board.getColumnHeightUnchecked(previousColumn) - 1);
+		}
+	}
+
+	GameSnapshot FourAcross::snapshot() const
+	{
+		if (getNumColumns() * getNumRows() > GameSnapshot::maxCells)
+		{
+			throw std::length_error("FourAcross::snapshot: board is too big for a snapshot");
 		}
-		catch (std::exception& error)
+
+		GameSnapshot snapshot{}; // unused cells are zeroed, so equal games make equal bytes
+		snapshot.numTurns = numTurns;
+		snapshot.numColumns = getNumColumns();
+		snapshot.numRows = getNumRows();
+		snapshot.numPlayers = numPlayers;
+		snapshot.currentPlayer = currentPlayer;
+		snapshot.winner = winner;
+		snapshot.winLength = winLength;
+		snapshot.winDetection = static_cast<uint8_t>(winDetection);
+		board.copyCellsTo(snapshot.cells);
+		std::copy(moveHistory.begin(), moveHistory.end(), snapshot.moves);
+		return snapshot;
+	}
+
+	void FourAcross::restore(const GameSnapshot& snapshot)
+	{
+		if (!isValidSnapshot(snapshot))
+		{
+			throw std::invalid_argument("FourAcross::restore: invalid snapshot");
+		}
+
+		if (snapshot.numColumns != getNumColumns() || snapshot.numRows != getNumRows() ||
+			snapshot.winLength != winLength || snapshot.winDetection != static_cast<uint8_t>(winDetection))
+		{
+			*this = FourAcross{snapshot.numPlayers, snapshot.currentPlayer, snapshot.numColumns, snapshot.numRows,
+				snapshot.winLength, static_cast<WinDetection>(snapshot.winDetection)};
+		}
+
+		board.assignCells(snapshot.cells);
+		moveHistory.assign(snapshot.moves, snapshot.moves + snapshot.numTurns);
+		numTurns = snapshot.numTurns;
+		numPlayers = snapshot.numPlayers;
+		currentPlayer = snapshot.currentPlayer;
+		winner = snapshot.winner;
+		lastMove = {0, 0};
+		if (!moveHistory.empty())
 		{
-			printDebug("FourAcross::takeTurn: fatal error taking turn", error.what(), "\n");
-			throw;
+			// the last move is the top piece of its column
+			lastMove = std::make_pair<>(moveHistory.back(), board.getColumnHeight(moveHistory.back()) - 1);
 		}
 
-		return TurnResult::success;
+		if (lineCounters.isEnabled())
+		{
+			// add the pieces back in the order they were played, so moves can still be undone
+			lineCounters = LineCounters{snapshot.numColumns, snapshot.numRows};
+			std::vector<uint8_t> heights(snapshot.numColumns, 0);
+			for (auto column : moveHistory)
+			{
+				const uint8_t row = heights[column]++;
+				lineCounters.addPiece(column, row, snapshot.cells[column * snapshot.numRows + row]);
+			}
+		}
 	}
 
 	FourAcross & FourAcross::operator=(FourAcross && connect) noexcept
 	{
 		board = std::move(connect.board);
+		lineCounters = std::move(connect.lineCounters);
+		moveHistory = std::move(connect.moveHistory);
+		winLength = connect.winLength;
+		winDetection = connect.winDetection;
 		numTurns = connect.numTurns;
 		numPlayers = connect.numPlayers;
 		lastMove = std::move(connect.lastMove);
@@ -102,179 +315,64 @@ namespace game
 		return *this;
 	}
 
-	uint8_t FourAcross::FourAcross::checkForWinner() const
+	uint8_t FourAcross::FourAcross::checkForWinner() const noexcept
 	{
 		const uint8_t lastColumn{lastMove.first};
 		const uint8_t lastRow{lastMove.second};
 
-		// assume the chain starts with the last move, and only check if
-		// the last player won
-		size_t count{1};
-		const uint8_t lastPlayer{board.getDiskOwnerAt(lastColumn, lastRow)};
-		const Board::column_view_t column{board.getColumn(lastColumn)};
-
-		// check up the column (0 would be bottom, numRows - 1 would be top), starting above
-		// the last move
-		for (uint8_t row = lastRow + 1; row < board.getNumRows(); ++row)
-		{
-			uint8_t current = column[row];
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
-		}
-
-		// check down the column, starting below the last move
-		for (uint8_t row = lastRow - 1; row != static_cast<uint8_t>(-1); --row)
-		{
-			uint8_t current = column[row];
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
-		}
+		// only check if the last player won, with a line through the last move
+		const uint8_t lastPlayer{board.getDiskOwnerAtUnchecked(lastColumn, lastRow)};
 
-		// check across the row
-		count = 1;
-		const Board::column_value_t row{board.getRow(lastRow)};
-
-		// scan row left to right, starting one to the right of last move
-		for (uint8_t col = lastColumn + 1; col < board.getNumColumns(); ++col)
+		if (winDetection == WinDetection::incremental)
 		{
-			uint8_t current = row[col];
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
+			return lineCounters.getLongestRunAt(lastColumn, lastRow) >= winLength ? lastPlayer : noWinner;
 		}
 
-		// check right to left, starting one to the left of last move
-		for (uint8_t col = lastColumn - 1; col != static_cast<uint8_t>(-1); --col)
+		if (winDetection == WinDetection::automatic && board.hasBitboard())
 		{
-			uint8_t current = row[col];
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
+			return board.hasLineOfLength(lastPlayer, winLength) ? lastPlayer : noWinner;
 		}
 
-		count = 1;
+		const bool hasWon =
+			countRun(board.getColumnUnchecked(lastColumn), lastRow, lastPlayer) >= winLength ||
+			countRun(board.getRowUnchecked(lastRow), lastColumn, lastPlayer) >= winLength ||
+			countRun(board.getDiagonalUnchecked(lastColumn, lastRow), std::min(lastColumn, lastRow), lastPlayer) >= winLength ||
+			countRun(board.getAntiDiagonalUnchecked(lastColumn, lastRow),
+				std::min<uint8_t>(lastColumn, board.getNumRows() - 1 - lastRow), lastPlayer) >= winLength;
 
-		// check up-right diagonal
-		for (uint8_t row = lastRow + 1, col = lastColumn + 1;
-			row < board.getNumRows() && col < board.getNumColumns();
-			++row, ++col)
-		{
-			uint8_t current = board.getDiskOwnerAt(col, row);
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
-		}
+		return hasWon ? lastPlayer : noWinner;
+	}
 
-		// check down-left diagonal
-		for (uint8_t row = lastRow - 1, col = lastColumn - 1;
-			row != static_cast<uint8_t>(-1) && col != static_cast<uint8_t>(-1);
-			--row, --col)
+	void FourAcross::finishMove(uint8_t column) noexcept
+	{
+		const uint8_t player = currentPlayer;
+		moveHistory.push_back(column);
+		currentPlayer = getNextPlayer();
+		lastMove = std::make_pair<>(column, board.getColumnHeightUnchecked(column) - 1);
+		++numTurns;
+		if (lineCounters.isEnabled())
 		{
-			uint8_t current = board.getDiskOwnerAt(col, row);
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
+			lineCounters.addPiece(lastMove.first, lastMove.second, player);
 		}
+		winner = checkForWinner();
+	}
 
-		count = 1;
-
-		// check up-left diagonal
-		for (uint8_t row = lastRow + 1, col = lastColumn - 1;
-			row < board.getNumRows() && col != static_cast<uint8_t>(-1);
-			++row, --col)
+	size_t FourAcross::countRun(const Board::line_view_t& line, size_t index, uint8_t player) noexcept
+	{
+		// scan forwards then backwards from the piece at index
+		size_t end = index + 1;
+		while (end < line.size() && line[end] == player)
 		{
-			uint8_t current = board.getDiskOwnerAt(col, row);
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
+			++end;
 		}
 
-		// check down-right diagonal
-		for (uint8_t row = lastRow - 1, col = lastColumn + 1;
-			row != static_cast<uint8_t>(-1) && col < board.getNumColumns();
-			--row, ++col)
+		size_t start = index;
+		while (start > 0 && line[start - 1] == player)
 		{
-			uint8_t current = board.getDiskOwnerAt(col, row);
-			if (current != lastPlayer)
-			{
-				break;
-			}
-			else
-			{
-				++count;
-				if (count == 4)
-				{
-					return lastPlayer;
-				}
-			}
+			--start;
 		}
 
-		return noWinner;
+		return end - start;
 	}
 
 	uint8_t FourAcross::FourAcross::getNextPlayer() const noexcept
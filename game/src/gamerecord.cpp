@@ -0,0 +1,222 @@
+#include "four-across/game/gamerecord.hpp"
+
+#include <limits>
+#include <stdexcept>
+
+namespace game
+{
+	constexpr size_t GameRecordWriter::headerSize;
+	constexpr uint8_t GameRecordWriter::maxColumns;
+	constexpr uint8_t GameRecordWriter::maxPlayers;
+
+	namespace
+	{
+		bool isRecordable(const GameRecordHeader& header) noexcept
+		{
+			return header.numColumns > 0 && header.numColumns <= GameRecordWriter::maxColumns &&
+				header.numPlayers > 0 && header.numPlayers <= GameRecordWriter::maxPlayers &&
+				header.firstPlayer > 0 && header.firstPlayer <= header.numPlayers;
+		}
+
+		// Value of each character as a hexadecimal digit, or 16 if it isn't one.
+		struct DigitTable
+		{
+			DigitTable() noexcept
+			{
+				for (auto& value : values)
+				{
+					value = 16;
+				}
+				for (uint8_t digit = 0; digit < 10; ++digit)
+				{
+					values['0' + digit] = digit;
+				}
+				for (uint8_t digit = 10; digit < 16; ++digit)
+				{
+					values['a' + digit - 10] = digit;
+					values['A' + digit - 10] = digit;
+				}
+			}
+
+			uint8_t values[256];
+		};
+
+		const char digits[] = "0123456789abcdef";
+	}
+
+	GameRecordWriter::GameRecordWriter(uint8_t* buffer, size_t capacity, const GameRecordHeader& header) :
+		buffer{buffer},
+		capacity{capacity},
+		numColumns{header.numColumns},
+		numMoves{0}
+	{
+		if (!isRecordable(header))
+		{
+			throw std::invalid_argument("GameRecordWriter: game settings can't be recorded");
+		}
+		if (capacity < headerSize)
+		{
+			throw std::invalid_argument("GameRecordWriter: buffer is too small for a record");
+		}
+
+		buffer[0] = header.numColumns;
+		buffer[1] = header.numRows;
+		buffer[2] = header.winLength;
+		buffer[3] = static_cast<uint8_t>(header.numPlayers << 4 | header.firstPlayer);
+		buffer[4] = 0;
+		buffer[5] = 0;
+	}
+
+	bool GameRecordWriter::addMove(uint8_t column) noexcept
+	{
+		if (column >= numColumns || numMoves == std::numeric_limits<uint16_t>::max() ||
+			getRecordSize(numMoves + 1) > capacity)
+		{
+			return false;
+		}
+
+		uint8_t& packed = buffer[headerSize + numMoves / 2];
+		packed = numMoves % 2 == 0 ? column : static_cast<uint8_t>(packed | column << 4);
+		++numMoves;
+		return true;
+	}
+
+	size_t GameRecordWriter::finish() noexcept
+	{
+		buffer[4] = static_cast<uint8_t>(numMoves);
+		buffer[5] = static_cast<uint8_t>(numMoves >> 8);
+		return getRecordSize(numMoves);
+	}
+
+	size_t GameRecordWriter::getRecordSize(size_t numMoves) noexcept
+	{
+		return headerSize + (numMoves + 1) / 2;
+	}
+
+	GameRecordReader::GameRecordReader(const uint8_t* data, size_t size) :
+		data{data},
+		header{},
+		nextIndex{0}
+	{
+		if (size < GameRecordWriter::headerSize)
+		{
+			throw std::invalid_argument("GameRecordReader: record is too short");
+		}
+
+		header.numColumns = data[0];
+		header.numRows = data[1];
+		header.winLength = data[2];
+		header.numPlayers = data[3] >> 4;
+		header.firstPlayer = data[3] & 0xf;
+		header.numMoves = static_cast<uint16_t>(data[4] | data[5] << 8);
+		if (!isRecordable(header))
+		{
+			throw std::invalid_argument("GameRecordReader: invalid record header");
+		}
+		if (size < getRecordSize())
+		{
+			throw std::invalid_argument("GameRecordReader: record is too short");
+		}
+	}
+
+	const GameRecordHeader& GameRecordReader::getHeader() const noexcept
+	{
+		return header;
+	}
+
+	bool GameRecordReader::nextMove(uint8_t& column) noexcept
+	{
+		if (nextIndex == header.numMoves)
+		{
+			return false;
+		}
+
+		const uint8_t packed = data[GameRecordWriter::headerSize + nextIndex / 2];
+		column = nextIndex % 2 == 0 ? packed & 0xf : packed >> 4;
+		++nextIndex;
+		return true;
+	}
+
+	size_t GameRecordReader::getRecordSize() const noexcept
+	{
+		return GameRecordWriter::getRecordSize(header.numMoves);
+	}
+
+	size_t writeGameRecord(const FourAcross& game, uint8_t* buffer, size_t capacity)
+	{
+		const auto& moves = game.getMoves();
+		if (moves.size() > std::numeric_limits<uint16_t>::max())
+		{
+			throw std::invalid_argument("writeGameRecord: game has too many moves to record");
+		}
+
+		// players take turns in order, so the first player is found from the one to move now
+		const uint8_t numPlayers = game.getNumPlayers();
+		const uint8_t firstPlayer = static_cast<uint8_t>(
+			(game.getCurrentPlayer() - 1 + numPlayers - moves.size() % numPlayers) % numPlayers + 1);
+		const GameRecordHeader header{game.getNumColumns(), game.getNumRows(), game.getWinLength(), numPlayers, firstPlayer, 0};
+		if (capacity < GameRecordWriter::getRecordSize(moves.size()))
+		{
+			return 0;
+		}
+
+		GameRecordWriter writer{buffer, capacity, header};
+		for (auto column : moves)
+		{
+			writer.addMove(column);
+		}
+		return writer.finish();
+	}
+
+	FourAcross readGameRecord(const uint8_t* data, size_t size)
+	{
+		GameRecordReader reader{data, size};
+		const GameRecordHeader& header = reader.getHeader();
+		FourAcross game{header.numPlayers, header.firstPlayer, header.numColumns, header.numRows, header.winLength};
+
+		uint8_t column = 0;
+		while (reader.nextMove(column))
+		{
+			if (game.takeTurn(game.getCurrentPlayer(), column) != FourAcross::TurnResult::success)
+			{
+				throw std::invalid_argument("readGameRecord: record has a move that can't be played");
+			}
+		}
+		return game;
+	}
+
+	void formatMoves(const uint8_t* columns, size_t numMoves, char* text) noexcept
+	{
+		for (size_t move = 0; move < numMoves; ++move)
+		{
+			text[move] = digits[columns[move] & 0xf];
+		}
+	}
+
+	std::string formatMoves(const FourAcross& game)
+	{
+		if (game.getNumColumns() > GameRecordWriter::maxColumns)
+		{
+			throw std::invalid_argument("formatMoves: game has columns that aren't one digit");
+		}
+
+		const auto& moves = game.getMoves();
+		std::string text(moves.size(), '0');
+		formatMoves(moves.data(), moves.size(), &text[0]);
+		return text;
+	}
+
+	void parseMoves(const char* text, size_t length, uint8_t* columns)
+	{
+		static const DigitTable table;
+		for (size_t move = 0; move < length; ++move)
+		{
+			const uint8_t column = table.values[static_cast<uint8_t>(text[move])];
+			if (column == 16)
+			{
+				throw std::invalid_argument("parseMoves: moves must be hexadecimal digits");
+			}
+			columns[move] = column;
+		}
+	}
+}
@@ -0,0 +1,82 @@
+#include "four-across/game/linecounters.hpp"
+#include "four-across/game/board.hpp"
+
+#include <algorithm>
+
+namespace game
+{
+	constexpr uint8_t LineCounters::numDirections;
+
+	LineCounters::LineCounters() noexcept :
+		numRows{0},
+		offsets{}
+	{
+	}
+
+	LineCounters::LineCounters(uint8_t numColumns, uint8_t numRows) :
+		numRows{numRows},
+		owners((numColumns + 2) * (numRows + 2), Board::emptySlot),
+		runs(owners.size() * numDirections, 0),
+		offsets{
+			1, // vertical
+			numRows + 2u, // horizontal
+			numRows + 3u, // diagonal, up and to the right
+			numRows + 1u} // anti-diagonal, down and to the right
+	{
+	}
+
+	void LineCounters::addPiece(uint8_t column, uint8_t row, uint8_t playerNum) noexcept
+	{
+		const size_t cell = getCellIndex(column, row);
+		owners[cell] = playerNum;
+
+		for (uint8_t direction = 0; direction < numDirections; ++direction)
+		{
+			// the neighbors, if they're the player's, are the ends of the runs being joined
+			const size_t offset = offsets[direction];
+			const size_t before = owners[cell - offset] == playerNum ? runs[(cell - offset) * numDirections + direction] : 0;
+			const size_t after = owners[cell + offset] == playerNum ? runs[(cell + offset) * numDirections + direction] : 0;
+			const uint8_t length = static_cast<uint8_t>(before + after + 1);
+
+			runs[(cell - before * offset) * numDirections + direction] = length;
+			runs[(cell + after * offset) * numDirections + direction] = length;
+			runs[cell * numDirections + direction] = length;
+		}
+	}
+
+	void LineCounters::removePiece(uint8_t column, uint8_t row) noexcept
+	{
+		const size_t cell = getCellIndex(column, row);
+		const uint8_t playerNum = owners[cell];
+		owners[cell] = Board::emptySlot;
+
+		for (uint8_t direction = 0; direction < numDirections; ++direction)
+		{
+			// addPiece only wrote the two ends of the joined run and the cell itself, so each neighbor
+			// still holds the length of its own run, unless it was a run of one that the join overwrote
+			const size_t offset = offsets[direction];
+			const uint8_t length = runs[cell * numDirections + direction];
+			const auto restoreRun = [&](size_t neighbor, ptrdiff_t step)
+			{
+				if (owners[neighbor] != playerNum)
+				{
+					return;
+				}
+				uint8_t& neighborRun = runs[neighbor * numDirections + direction];
+				const uint8_t runLength = neighborRun == length ? 1 : neighborRun;
+				neighborRun = runLength;
+				runs[(neighbor + step * (runLength - 1)) * numDirections + direction] = runLength;
+			};
+			restoreRun(cell - offset, -static_cast<ptrdiff_t>(offset));
+			restoreRun(cell + offset, static_cast<ptrdiff_t>(offset));
+
+			runs[cell * numDirections + direction] = 0;
+		}
+	}
+
+	uint8_t LineCounters::getLongestRunAt(uint8_t column, uint8_t row) const noexcept
+	{
+		const uint8_t* const cellRuns = &runs[getCellIndex(column, row) * numDirections];
+		return std::max(std::max(cellRuns[0], cellRuns[1]), std::max(cellRuns[2], cellRuns[3]));
+	}
+}
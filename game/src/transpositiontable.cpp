@@ -0,0 +1,224 @@
+#include "four-across/game/transpositiontable.hpp"
+
+#include <cstdlib>
+#include <limits>
+#include <new>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+namespace game
+{
+	constexpr size_t TranspositionTable::entriesPerBucket;
+	constexpr size_t TranspositionTable::bucketSize;
+
+	static_assert(sizeof(TranspositionTable::Entry) <= sizeof(uint64_t), "entries must pack into one word");
+
+	TranspositionTable::TranspositionTable(size_t numBytes, bool useHugePages) :
+		buckets{nullptr},
+		numBuckets{1},
+		memory{nullptr},
+		memorySize{0},
+		isMapped{false},
+		hasHugePages{false},
+		generation{0}
+	{
+		static_assert(sizeof(Bucket) == bucketSize, "buckets must fill one cache line");
+
+		while (numBuckets * 2 * sizeof(Bucket) <= numBytes)
+		{
+			numBuckets *= 2;
+		}
+
+		allocate(numBuckets * sizeof(Bucket), useHugePages);
+		for (size_t i = 0; i < numBuckets; ++i)
+		{
+			new (&buckets[i]) Bucket;
+		}
+		clear();
+	}
+
+	TranspositionTable::~TranspositionTable()
+	{
+#if defined(__linux__)
+		if (isMapped)
+		{
+			munmap(memory, memorySize);
+			return;
+		}
+#endif
+		std::free(memory);
+	}
+
+	bool TranspositionTable::probe(uint64_t key, Entry& entry) const noexcept
+	{
+		const Bucket& bucket = getBucket(key);
+		for (const Slot& slot : bucket.slots)
+		{
+			const uint64_t data = slot.data.load(std::memory_order_relaxed);
+			const uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+			if ((keyXorData ^ data) == key)
+			{
+				entry = unpack(data);
+				return entry.bound != Bound::none;
+			}
+		}
+		return false;
+	}
+
+	void TranspositionTable::store(uint64_t key, const Entry& entry) noexcept
+	{
+		if (entry.bound == Bound::none)
+		{
+			return;
+		}
+
+		const uint8_t currentGeneration = generation.load(std::memory_order_relaxed);
+		Bucket& bucket = getBucket(key);
+
+		Slot* replaced = &bucket.slots[0];
+		int lowestValue = std::numeric_limits<int>::max();
+		for (Slot& slot : bucket.slots)
+		{
+			const uint64_t data = slot.data.load(std::memory_order_relaxed);
+			const uint64_t keyXorData = slot.keyXorData.load(std::memory_order_relaxed);
+			if ((keyXorData ^ data) == key)
+			{
+				replaced = &slot;
+				break;
+			}
+
+			// each search of age counts as much as 8 plies of depth, and empty slots go first
+			const Entry existing = unpack(data);
+			const uint8_t age = currentGeneration - getGeneration(data);
+			const int value = existing.bound == Bound::none ?
+				std::numeric_limits<int>::min() :
+				existing.depth - 8 * age;
+			if (value < lowestValue)
+			{
+				lowestValue = value;
+				replaced = &slot;
+			}
+		}
+
+		const uint64_t data = pack(entry, currentGeneration);
+		replaced->data.store(data, std::memory_order_relaxed);
+		replaced->keyXorData.store(key ^ data, std::memory_order_relaxed);
+	}
+
+	void TranspositionTable::startNewSearch() noexcept
+	{
+		generation.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void TranspositionTable::clear() noexcept
+	{
+		for (size_t i = 0; i < numBuckets; ++i)
+		{
+			for (Slot& slot : buckets[i].slots)
+			{
+				slot.data.store(0, std::memory_order_relaxed);
+				slot.keyXorData.store(0, std::memory_order_relaxed);
+			}
+		}
+		generation.store(0, std::memory_order_relaxed);
+	}
+
+	uint64_t TranspositionTable::pack(const Entry& entry, uint8_t generation) noexcept
+	{
+		return static_cast<uint64_t>(static_cast<uint16_t>(entry.score)) |
+			static_cast<uint64_t>(entry.depth) << 16 |
+			static_cast<uint64_t>(entry.bound) << 24 |
+			static_cast<uint64_t>(entry.bestMove) << 32 |
+			static_cast<uint64_t>(generation) << 40;
+	}
+
+	TranspositionTable::Entry TranspositionTable::unpack(uint64_t data) noexcept
+	{
+		Entry entry;
+		entry.score = static_cast<int16_t>(data & 0xffff);
+		entry.depth = static_cast<uint8_t>(data >> 16);
+		entry.bound = static_cast<Bound>(static_cast<uint8_t>(data >> 24));
+		entry.bestMove = static_cast<uint8_t>(data >> 32);
+		return entry;
+	}
+
+	uint8_t TranspositionTable::getGeneration(uint64_t data) noexcept
+	{
+		return static_cast<uint8_t>(data >> 40);
+	}
+
+	TranspositionTable::Bucket& TranspositionTable::getBucket(uint64_t key) const noexcept
+	{
+		return buckets[key & (numBuckets - 1)];
+	}
+
+	void TranspositionTable::allocate(size_t numBytes, bool useHugePages)
+	{
+#if defined(__linux__)
+		const size_t hugePageSize = size_t{2} << 20;
+		const size_t hugeSize = (numBytes + hugePageSize - 1) / hugePageSize * hugePageSize;
+		if (useHugePages)
+		{
+			void* const hugeMemory = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE,
+				MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (hugeMemory != MAP_FAILED)
+			{
+				memory = hugeMemory;
+				memorySize = hugeSize;
+				isMapped = true;
+				hasHugePages = true;
+				buckets = static_cast<Bucket*>(memory);
+				return;
+			}
+		}
+
+		// explicit huge pages need pages reserved by the administrator, so fall back to normal memory,
+		// aligned to a huge page and advised as transparent huge pages so the kernel can back it with
+		// them if they're enabled; whether it does can't be known here, so hasHugePages stays false
+		const size_t mappedSize = useHugePages ? hugeSize + hugePageSize : numBytes;
+		void* const mappedMemory = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mappedMemory == MAP_FAILED)
+		{
+			throw std::bad_alloc{};
+		}
+		memory = mappedMemory;
+		memorySize = mappedSize;
+		isMapped = true;
+		if (useHugePages)
+		{
+			// unmap the pages before the first huge page boundary and after the table
+			char* const mapped = static_cast<char*>(mappedMemory);
+			const uintptr_t address = reinterpret_cast<uintptr_t>(mapped);
+			char* const aligned = mapped + ((hugePageSize - address % hugePageSize) % hugePageSize);
+			if (aligned != mapped)
+			{
+				munmap(mapped, aligned - mapped);
+			}
+			const size_t tailSize = mapped + mappedSize - (aligned + hugeSize);
+			if (tailSize != 0)
+			{
+				munmap(aligned + hugeSize, tailSize);
+			}
+			memory = aligned;
+			memorySize = hugeSize;
+#if defined(MADV_HUGEPAGE)
+			madvise(memory, memorySize, MADV_HUGEPAGE);
+#endif
+		}
+		buckets = static_cast<Bucket*>(memory);
+#else
+		// malloc only guarantees alignment for fundamental types, so align buckets to cache lines by hand
+		(void)useHugePages;
+		memory = std::malloc(numBytes + sizeof(Bucket));
+		if (memory == nullptr)
+		{
+			throw std::bad_alloc{};
+		}
+		memorySize = numBytes + sizeof(Bucket);
+		const uintptr_t address = reinterpret_cast<uintptr_t>(memory);
+		buckets = reinterpret_cast<Bucket*>((address + sizeof(Bucket) - 1) / sizeof(Bucket) * sizeof(Bucket));
+#endif
+	}
+}
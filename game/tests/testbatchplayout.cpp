@@ -0,0 +1,132 @@
+#include "four-across/game/batchplayout.hpp"
+#include "four-across/game/game.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+namespace
+{
+	// Plays random games from position one move at a time with takeTurn, for comparison.
+	game::PlayoutCounts playOutScalar(const game::FourAcross& position, uint32_t numPlayouts, std::mt19937_64& rng)
+	{
+		game::PlayoutCounts counts{};
+		const uint8_t player = position.getCurrentPlayer();
+		for (uint32_t i = 0; i < numPlayouts; ++i)
+		{
+			game::FourAcross played{position};
+			while (!played.hasWinner() && !played.boardFull())
+			{
+				played.takeTurn(played.getCurrentPlayer(), rng() % played.getNumColumns());
+			}
+			++(played.boardFull() && !played.hasWinner() ? counts.draws :
+				played.getWinner() == player ? counts.wins : counts.losses);
+		}
+		return counts;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	std::mt19937_64 rng{7};
+
+	{
+		// win rates of random games match playing them one move at a time
+		const uint8_t settings[][3] = {{5, 4, 4}, {7, 6, 4}, {6, 5, 3}, {9, 7, 5}};
+		for (const auto& setting : settings)
+		{
+			BatchPlayout playout{setting[0], setting[1], setting[2]};
+			std::vector<FourAcross> positions(3, FourAcross{2, 1, setting[0], setting[1], setting[2]});
+			positions[1].takeTurn(1, setting[0] / 2);
+			positions[2].takeTurn(1, 0);
+			positions[2].takeTurn(2, 0);
+			positions[2].takeTurn(1, 1);
+
+			const uint32_t numPlayouts = 40000;
+			std::vector<PlayoutCounts> counts(positions.size());
+			playout.playoutBatch(positions.data(), positions.size(), numPlayouts, rng, counts.data());
+			for (size_t i = 0; i < positions.size(); ++i)
+			{
+				assert(counts[i].wins + counts[i].losses + counts[i].draws == numPlayouts);
+				const PlayoutCounts expected = playOutScalar(positions[i], numPlayouts, rng);
+				assert(std::abs(static_cast<double>(counts[i].wins) - expected.wins) / numPlayouts < 0.015);
+				assert(std::abs(static_cast<double>(counts[i].losses) - expected.losses) / numPlayouts < 0.015);
+			}
+		}
+	}
+
+	{
+		// finished positions count every game as over
+		BatchPlayout playout{5, 4};
+		std::vector<FourAcross> positions(3, FourAcross{2, 1, 5, 4});
+		for (auto column : {0, 1, 0, 1, 0, 1, 0})
+		{
+			positions[0].takeTurn(positions[0].getCurrentPlayer(), column);
+		}
+		for (auto column : {1, 0, 3, 2, 4, 0, 1, 2})
+		{
+			positions[1].takeTurn(positions[1].getCurrentPlayer(), column);
+		}
+
+		std::vector<PlayoutCounts> counts(positions.size());
+		playout.playoutBatch(positions.data(), positions.size(), 100, rng, counts.data());
+		assert(counts[0].losses == 100 && counts[0].wins == 0 && counts[0].draws == 0);
+		assert(counts[1].wins + counts[1].losses + counts[1].draws == 100);
+		assert(counts[2].wins + counts[2].losses + counts[2].draws == 100);
+
+		playout.playoutBatch(positions.data(), positions.size(), 0, rng, counts.data());
+		assert(counts[2].wins == 0 && counts[2].losses == 0 && counts[2].draws == 0);
+	}
+
+	{
+		// throughput against playing one move at a time
+		BatchPlayout playout{7, 6};
+		const FourAcross position{2, 1, 7, 6};
+		PlayoutCounts counts{};
+
+		auto startTime = std::chrono::steady_clock::now();
+		playout.playoutBatch(&position, 1, 1000000, rng, &counts);
+		const std::chrono::duration<double> batchTime = std::chrono::steady_clock::now() - startTime;
+
+		startTime = std::chrono::steady_clock::now();
+		playOutScalar(position, 100000, rng);
+		const std::chrono::duration<double> scalarTime = std::chrono::steady_clock::now() - startTime;
+		std::cout << 1000000 / batchTime.count() << " batched playouts/s, "
+			<< 100000 / scalarTime.count() << " with takeTurn\n";
+	}
+
+	{
+		bool threw = false;
+		try
+		{
+			BatchPlayout{9, 8};
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		threw = false;
+		try
+		{
+			BatchPlayout playout{7, 6};
+			const FourAcross position{3, 1, 7, 6};
+			PlayoutCounts counts{};
+			playout.playoutBatch(&position, 1, 1, rng, &counts);
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -1,5 +1,6 @@
 #include "four-across/game/board.hpp"
 
+#include <cassert>
 #include <iostream>
 #include <string>
 
@@ -61,6 +62,28 @@ int main(int argc, char* argv[])
 	// string conversion
 	std::cout << board << "\n";
 
+	{
+		std::cout << "diagonal through 2,1:\n";
+		Board::line_view_t diagonal = board.getDiagonal(2, 1);
+		assert(diagonal.size() == 6);
+		assert(diagonal[1] == board.getDiskOwnerAt(2, 1));
+		for (auto& playerId : diagonal)
+		{
+			std::cout << static_cast<int>(playerId) << "\n";
+		}
+	}
+
+	{
+		std::cout << "anti-diagonal through last column, first row:\n";
+		Board::line_view_t diagonal = board.getAntiDiagonal(columns - 1, 0);
+		assert(diagonal.size() == 6);
+		assert(diagonal[5] == board.getDiskOwnerAt(columns - 1, 0));
+		for (auto& playerId : diagonal)
+		{
+			std::cout << static_cast<int>(playerId) << "\n";
+		}
+	}
+
 	for (int i = 0; i < columns; ++i)
 	{
 		for (int j = 0; j < rows; ++j)
@@ -72,6 +95,53 @@ int main(int argc, char* argv[])
 
 	std::cout << "is board full?: " << board.isFull() << "\n";
 	
+	{
+		// taking pieces back out empties the column again
+		assert(board.removePieceFromColumn(0));
+		assert(!board.isFull());
+		assert(board.getColumnHeight(0) == rows - 1);
+		assert(board.getDiskOwnerAt(0, rows - 1) == Board::emptySlot);
+		while (board.removePieceFromColumn(0))
+		{
+		}
+		assert(board.getColumnHeight(0) == 0);
+		assert(board.getDiskOwnerAt(0, 0) == Board::emptySlot);
+		board.pushPiece(0, 2);
+		assert(board.getDiskOwnerAt(0, 0) == 2);
+		board.popPiece(0);
+		assert(board.getColumnHeight(0) == 0);
+	}
+
+	{
+		// the try* operations report bad input instead of throwing
+		uint8_t owner{Board::emptySlot};
+		uint8_t height{0};
+		bool isColumnFull{false};
+		assert(board.tryDropPieceInColumn(columns, 1) == Board::Status::outOfRange);
+		assert(board.tryRemovePieceFromColumn(columns) == Board::Status::outOfRange);
+		assert(board.tryRemovePieceFromColumn(0) == Board::Status::columnEmpty);
+		assert(board.tryGetDiskOwnerAt(0, rows, owner) == Board::Status::outOfRange);
+		assert(board.tryGetColumnHeight(columns, height) == Board::Status::outOfRange);
+		assert(board.tryIsColumnFull(1, isColumnFull) == Board::Status::success && isColumnFull);
+		assert(board.tryDropPieceInColumn(1, 1) == Board::Status::columnFull);
+		assert(board.tryDropPieceInColumn(0, 2) == Board::Status::success);
+		assert(board.tryGetDiskOwnerAt(0, 0, owner) == Board::Status::success && owner == 2);
+		assert(board.tryGetColumnHeight(0, height) == Board::Status::success && height == 1);
+		assert(board.tryRemovePieceFromColumn(0) == Board::Status::success);
+	}
+
+	{
+		// the unchecked accessors agree with the checked ones on the board
+		board.dropPieceInColumn(0, 2);
+		assert(board.getDiskOwnerAtUnchecked(0, 0) == board.getDiskOwnerAt(0, 0));
+		assert(board.getColumnHeightUnchecked(0) == 1);
+		assert(board.getColumnUnchecked(1).size() == board.getColumn(1).size());
+		assert(board.getRowUnchecked(0)[0] == 2);
+		assert(board.getDiagonalUnchecked(1, 1)[0] == board.getDiagonal(1, 1)[0]);
+		assert(board.getAntiDiagonalUnchecked(0, 0).size() == board.getAntiDiagonal(0, 0).size());
+		board.removePieceFromColumn(0);
+	}
+
 
 	try
 	{
@@ -196,6 +266,24 @@ int main(int argc, char* argv[])
 		std::cout << "caught exception: " << e.what() << "\n";
 	}
 
+	try
+	{
+		board.getDiagonal(columns, 0);
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "caught exception: " << e.what() << "\n";
+	}
+
+	try
+	{
+		board.getAntiDiagonal(0, rows);
+	}
+	catch (std::exception& e)
+	{
+		std::cout << "caught exception: " << e.what() << "\n";
+	}
+
 	Board board1{std::move(board)};
 	std::cout << "moved board->board1, board1(numColumns=" 
 		<< static_cast<int>(board1.getNumColumns()) << ", numRows=" << static_cast<int>(board1.getNumRows()) << ")\n";
@@ -0,0 +1,78 @@
+#include "four-across/game/fixedboard.hpp"
+#include "four-across/game/fixedgame.hpp"
+#include "four-across/game/game.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <type_traits>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	// tables are built at compile time
+	static_assert(FixedBoard<7, 6>::tables.directionShifts[2] == 7, "up-right diagonals step one column and one row");
+	static_assert(FixedBoard<7, 6>::tables.cellOffsets[6][5] == 41, "cells are stored column by column");
+	static_assert(FixedBoard<9, 7>::tables.columnMasks[8] >> 56 == 0x7f, "last column of 9x7 is the top 7 bits");
+
+	{
+		FixedBoard<7, 6> board{};
+		for (uint8_t row = 0; row < 6; ++row)
+		{
+			assert(board.dropPieceInColumn(3, 1 + row % 2));
+		}
+		assert(!board.dropPieceInColumn(3, 1));
+		assert(board.isColumnFull(3));
+		assert(board.getDiskOwnerAt(3, 0) == 1);
+		assert(board.getDiskOwnerAt(3, 5) == 2);
+		assert(board.getDiskOwnerAt(0, 0) == Board::emptySlot);
+		assert(!board.isFull());
+
+		try
+		{
+			board.dropPieceInColumn(7, 1);
+			assert(false);
+		}
+		catch (std::out_of_range& e)
+		{
+			std::cout << "caught exception: " << e.what() << "\n";
+		}
+	}
+
+	{
+		// the factory picks the specialization for common sizes
+		const bool isFixed = visitFourAcross([](auto& game)
+			{
+				return !std::is_same<std::decay_t<decltype(game)>, FourAcross>::value;
+			}, 2, 1, 7, 6);
+		assert(isFixed);
+
+		const bool isGeneric = visitFourAcross([](auto& game)
+			{
+				return std::is_same<std::decay_t<decltype(game)>, FourAcross>::value;
+			}, 2, 1, 10, 8);
+		assert(isGeneric);
+	}
+
+	{
+		// play the same random games on both boards and compare results
+		std::default_random_engine engine{1234};
+		for (int i = 0; i < 1000; ++i)
+		{
+			FixedFourAcross<9, 7> fixedGame{2, 1};
+			FourAcross game{2, 1, 9, 7};
+			while (!game.hasWinner() && !game.boardFull())
+			{
+				const uint8_t column = engine() % 9;
+				const auto result = game.takeTurn(game.getCurrentPlayer(), column);
+				assert(fixedGame.takeTurn(fixedGame.getCurrentPlayer(), column) == result);
+				assert(fixedGame.getWinner() == game.getWinner());
+				assert(fixedGame.boardFull() == game.boardFull());
+			}
+			assert(fixedGame.getNumTurns() == game.getNumTurns());
+		}
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -2,7 +2,11 @@
 #include "four-across/game/game.hpp"
 
 #include <cassert>
+#include <cstring>
 #include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
 
 int main(int argc, char* argv[])
 {
@@ -333,5 +337,237 @@ int main(int argc, char* argv[])
 		std::cout << game << "\n";
 	}
 
+	{
+		FourAcross game{};
+
+		// pieces at the top of one column and the bottom of the next are adjacent on the
+		// bitboard, but must not count as a line
+		const uint8_t moves[] = {2, 0, 3, 0, 0, 4, 0, 4, 1, 4, 1};
+		for (auto column : moves)
+		{
+			FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), column);
+			assert(result == FourAcross::TurnResult::success);
+			assert(game.getWinner() == FourAcross::noWinner);
+		}
+
+		// player 2 finishes their column
+		FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), 4);
+		assert(result == FourAcross::TurnResult::success);
+		assert(game.getWinner() == 2);
+
+		std::cout << game << "\n";
+	}
+
+	{
+		// incremental win detection on a large board: player 1 wins joining two runs of two in a row
+		FourAcross game{2, 1, 100, 50, FourAcross::defaultWinLength, FourAcross::WinDetection::incremental};
+		const uint8_t moves[] = {10, 10, 11, 11, 13, 13};
+		for (auto column : moves)
+		{
+			FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), column);
+			assert(result == FourAcross::TurnResult::success);
+			assert(game.getWinner() == FourAcross::noWinner);
+		}
+
+		FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), 12);
+		assert(result == FourAcross::TurnResult::success);
+		assert(game.getWinner() == 1);
+	}
+
+	{
+		// connect-K: a row of winLength pieces wins, one fewer doesn't, with every win detection on small,
+		// wide and grid boards. Lengths 3 to 6 have their own checks, 2 and 7 use the generic one.
+		const uint8_t sizes[][2] = {{9, 7}, {16, 12}, {30, 20}};
+		const FourAcross::WinDetection detections[] = {
+			FourAcross::WinDetection::automatic, FourAcross::WinDetection::scan, FourAcross::WinDetection::incremental};
+		for (const auto& size : sizes)
+		{
+			for (auto detection : detections)
+			{
+				for (uint8_t winLength = FourAcross::minWinLength; winLength <= 7; ++winLength)
+				{
+					FourAcross game{2, 1, size[0], size[1], winLength, detection};
+					assert(game.getWinLength() == winLength);
+
+					// player 1 builds a row along the bottom, player 2 stacks on top of it
+					for (uint8_t column = 0; column < winLength - 1; ++column)
+					{
+						assert(game.takeTurn(1, column) == FourAcross::TurnResult::success);
+						assert(game.takeTurn(2, column) == FourAcross::TurnResult::success);
+						assert(game.getWinner() == FourAcross::noWinner);
+					}
+					assert(game.takeTurn(1, winLength - 1) == FourAcross::TurnResult::success);
+					assert(game.getWinner() == 1);
+				}
+			}
+		}
+
+		try
+		{
+			FourAcross game{2, 1, 7, 6, 8};
+			assert(false);
+		}
+		catch (std::invalid_argument& e)
+		{
+			std::cout << "caught exception: " << e.what() << "\n";
+		}
+	}
+
+	{
+		// undoing every turn of random games and replaying them with makeMove gives the same results
+		std::default_random_engine engine{99};
+		const uint8_t sizes[][2] = {{7, 6}, {10, 8}, {16, 12}, {30, 20}};
+		const FourAcross::WinDetection detections[] = {
+			FourAcross::WinDetection::automatic, FourAcross::WinDetection::scan, FourAcross::WinDetection::incremental};
+		for (int i = 0; i < 120; ++i)
+		{
+			const auto& size = sizes[i % 4];
+			FourAcross game{3, 1, size[0], size[1], FourAcross::defaultWinLength, detections[i % 3]};
+			std::vector<uint8_t> columns;
+			std::vector<uint8_t> winners;
+			while (!game.hasWinner() && !game.boardFull())
+			{
+				const uint8_t column = engine() % size[0];
+				if (game.takeTurn(game.getCurrentPlayer(), column) == FourAcross::TurnResult::success)
+				{
+					columns.push_back(column);
+					winners.push_back(game.getWinner());
+				}
+			}
+
+			while (game.getNumTurns() > 0)
+			{
+				const uint8_t player = game.getCurrentPlayer();
+				assert(game.undoTurn());
+				assert(game.getWinner() == FourAcross::noWinner);
+				assert(game.getCurrentPlayer() == (player == 1 ? 3 : player - 1));
+			}
+			assert(!game.undoTurn());
+			assert(game.getCurrentPlayer() == 1);
+
+			for (size_t move = 0; move < columns.size(); ++move)
+			{
+				game.makeMove(columns[move]);
+				assert(game.getWinner() == winners[move]);
+			}
+			game.unmakeMove();
+			game.makeMove(columns.back());
+			assert(game.getWinner() == winners.back());
+			assert(game.getNumTurns() == columns.size());
+		}
+	}
+
+	{
+		// snapshots copied as raw bytes restore the same game, which then plays on identically
+		std::default_random_engine engine{7};
+		const uint8_t sizes[][2] = {{7, 6}, {16, 12}};
+		for (int i = 0; i < 60; ++i)
+		{
+			const auto& size = sizes[i % 2];
+			const auto detection = static_cast<FourAcross::WinDetection>(i % 3);
+			FourAcross game{2, 1, size[0], size[1], FourAcross::defaultWinLength, detection};
+			for (int turn = 0; turn < 10 && !game.hasWinner(); ++turn)
+			{
+				game.takeTurn(game.getCurrentPlayer(), engine() % size[0]);
+			}
+
+			unsigned char buffer[sizeof(GameSnapshot)];
+			const GameSnapshot snapshot = game.snapshot();
+			std::memcpy(buffer, &snapshot, sizeof(snapshot));
+			GameSnapshot copy;
+			std::memcpy(&copy, buffer, sizeof(copy));
+
+			FourAcross restored{};
+			restored.restore(copy);
+			assert(restored.getNumTurns() == game.getNumTurns());
+			assert(restored.getCurrentPlayer() == game.getCurrentPlayer());
+			assert(restored.getWinner() == game.getWinner());
+			assert(restored.getWinDetection() == detection);
+			assert(std::string{restored} == std::string{game});
+
+			while (!game.hasWinner() && !game.boardFull())
+			{
+				const uint8_t column = engine() % size[0];
+				assert(restored.takeTurn(restored.getCurrentPlayer(), column) == game.takeTurn(game.getCurrentPlayer(), column));
+				assert(restored.getWinner() == game.getWinner());
+			}
+
+			// restoring into a game with the same settings reuses it, and moves before the snapshot can still be undone
+			restored.restore(copy);
+			while (restored.undoTurn())
+			{
+			}
+			assert(restored.getNumTurns() == 0);
+			assert(restored.getCurrentPlayer() == 1);
+		}
+
+		try
+		{
+			FourAcross game{2, 1, 30, 20};
+			game.snapshot();
+			assert(false);
+		}
+		catch (std::length_error& e)
+		{
+			std::cout << "caught exception: " << e.what() << "\n";
+		}
+	}
+
+	{
+		// corrupted snapshots are rejected, and the game they were restored into is left as it was
+		FourAcross game{2, 1, 7, 6};
+		game.takeTurn(1, 3);
+		game.takeTurn(2, 3);
+		game.takeTurn(1, 4);
+		const GameSnapshot valid = game.snapshot();
+
+		std::vector<GameSnapshot> corrupted(10, valid);
+		corrupted[0].moves[0] = 5; // a move that doesn't match the cells
+		corrupted[1].moves[2] = 3; // too many pieces in a column
+		corrupted[2].numTurns = 2; // fewer moves than pieces
+		corrupted[3].numTurns = 4;
+		corrupted[4].cells[3 * 6 + 1] = Board::emptySlot; // a gap under a piece
+		corrupted[5].cells[0] = 1; // a piece no move placed
+		corrupted[6].cells[3 * 6] = 3; // a player not in the game
+		corrupted[7].numPlayers = 0;
+		corrupted[8].currentPlayer = 200;
+		corrupted[9].winner = 3;
+
+		for (const auto& snapshot : corrupted)
+		{
+			FourAcross restored{2, 1, 7, 6};
+			restored.takeTurn(1, 0);
+			bool threw = false;
+			try
+			{
+				restored.restore(snapshot);
+			}
+			catch (std::invalid_argument&)
+			{
+				threw = true;
+			}
+			assert(threw);
+			assert(restored.getNumTurns() == 1);
+
+			threw = false;
+			try
+			{
+				FourAcross constructed{snapshot};
+			}
+			catch (std::invalid_argument&)
+			{
+				threw = true;
+			}
+			assert(threw);
+		}
+
+		FourAcross restored{valid};
+		assert(restored.getNumTurns() == 3);
+		const bool undid = restored.undoTurn();
+		assert(undid);
+		assert(restored.getCurrentPlayer() == 1);
+		assert(restored.getBoard().getColumnHeight(4) == 0);
+	}
+
 	std::cout << "tests passed\n";
 }
\ No newline at end of file
@@ -0,0 +1,183 @@
+#include "four-across/game/game.hpp"
+#include "four-across/game/gamerecord.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	std::default_random_engine engine{11};
+	const auto playRandomGame = [&engine](FourAcross game)
+	{
+		while (!game.hasWinner() && !game.boardFull())
+		{
+			game.takeTurn(game.getCurrentPlayer(), engine() % game.getNumColumns());
+		}
+		return game;
+	};
+
+	{
+		// games read back with the same settings and moves, and a full 7x6 game takes 27 bytes
+		uint8_t buffer[GameRecordWriter::getRecordSize(16 * 15)];
+		for (auto settings : {FourAcross{}, FourAcross{2, 2, 7, 6}, FourAcross{3, 2, 8, 7}, FourAcross{15, 9, 16, 15, 5}})
+		{
+			for (int i = 0; i < 20; ++i)
+			{
+				const FourAcross game = playRandomGame(settings);
+				const size_t size = writeGameRecord(game, buffer, sizeof(buffer));
+				assert(size == GameRecordWriter::headerSize + (game.getNumTurns() + 1) / 2);
+
+				const FourAcross read = readGameRecord(buffer, size);
+				assert(read.getMoves() == game.getMoves());
+				assert(read.getKey() == game.getKey());
+				assert(read.getWinner() == game.getWinner());
+				assert(read.getNumPlayers() == game.getNumPlayers() && read.getWinLength() == game.getWinLength());
+			}
+		}
+		assert(GameRecordWriter::getRecordSize(42) == 27);
+
+		// a buffer too small for the game isn't written past
+		FourAcross game = playRandomGame(FourAcross{2, 1, 7, 6});
+		std::memset(buffer, 0xee, sizeof(buffer));
+		assert(writeGameRecord(game, buffer, 8) == 0);
+		assert(buffer[0] == 0xee);
+	}
+
+	{
+		// records stored back to back are scanned one move at a time
+		std::vector<uint8_t> archive(1 << 16);
+		std::vector<FourAcross> games;
+		size_t used = 0;
+		for (int i = 0; i < 200; ++i)
+		{
+			games.push_back(playRandomGame(FourAcross{2, 1, 7, 6}));
+			GameRecordWriter writer{archive.data() + used, archive.size() - used, GameRecordHeader{7, 6, 4, 2, 1, 0}};
+			for (auto column : games.back().getMoves())
+			{
+				assert(writer.addMove(column));
+			}
+			assert(!writer.addMove(7));
+			used += writer.finish();
+		}
+
+		size_t offset = 0;
+		for (const auto& game : games)
+		{
+			GameRecordReader reader{archive.data() + offset, used - offset};
+			assert(reader.getHeader().numMoves == game.getNumTurns());
+			uint8_t column = 0;
+			for (auto expected : game.getMoves())
+			{
+				assert(reader.nextMove(column) && column == expected);
+			}
+			assert(!reader.nextMove(column));
+			offset += reader.getRecordSize();
+		}
+		assert(offset == used);
+
+		// a writer stops at the end of its buffer
+		uint8_t small[8];
+		GameRecordWriter writer{small, sizeof(small), GameRecordHeader{7, 6, 4, 2, 1, 0}};
+		for (int move = 0; move < 4; ++move)
+		{
+			assert(writer.addMove(3));
+		}
+		assert(!writer.addMove(3));
+		assert(writer.finish() == 8);
+	}
+
+	{
+		// the text form is one hexadecimal digit per move
+		FourAcross game{2, 1, 12, 6};
+		for (auto column : {3, 11, 10, 0})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		assert(formatMoves(game) == "3ba0");
+
+		uint8_t columns[4];
+		parseMoves("3BA0", 4, columns);
+		assert(columns[0] == 3 && columns[1] == 11 && columns[2] == 10 && columns[3] == 0);
+
+		bool threw = false;
+		try
+		{
+			parseMoves("3g", 2, columns);
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		// a round trip through text for many games, timed
+		std::vector<std::string> texts;
+		for (int i = 0; i < 2000; ++i)
+		{
+			texts.push_back(formatMoves(playRandomGame(FourAcross{2, 1, 7, 6})));
+		}
+		size_t numMoves = 0;
+		uint8_t parsed[42];
+		const auto startTime = std::chrono::steady_clock::now();
+		for (int repeat = 0; repeat < 50; ++repeat)
+		{
+			for (const auto& text : texts)
+			{
+				parseMoves(text.data(), text.size(), parsed);
+				numMoves += text.size();
+			}
+		}
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+		std::cout << numMoves / elapsed.count() << " moves parsed/s\n";
+	}
+
+	{
+		// settings that don't fit the header are refused, and so are corrupt records
+		uint8_t buffer[32];
+		bool threw = false;
+		try
+		{
+			writeGameRecord(FourAcross{2, 1, 17, 6}, buffer, sizeof(buffer));
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		FourAcross game{};
+		game.takeTurn(1, 0);
+		const size_t size = writeGameRecord(game, buffer, sizeof(buffer));
+		threw = false;
+		try
+		{
+			GameRecordReader{buffer, size - 1};
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		buffer[GameRecordWriter::headerSize] = 9;
+		threw = false;
+		try
+		{
+			readGameRecord(buffer, size);
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,120 @@
+#include "four-across/game/game.hpp"
+#include "four-across/game/transpositiontable.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	{
+		// the same position reached by different move orders has the same key, and undoing restores it
+		FourAcross first{};
+		FourAcross second{};
+		const uint64_t emptyKey = first.getKey();
+		for (auto column : {0, 1, 2, 3})
+		{
+			first.takeTurn(first.getCurrentPlayer(), column);
+		}
+		for (auto column : {2, 3, 0, 1})
+		{
+			second.takeTurn(second.getCurrentPlayer(), column);
+		}
+		assert(first.getKey() == second.getKey());
+		assert(first.getKey() != emptyKey);
+
+		first.undoTurn();
+		assert(first.getKey() != second.getKey());
+		while (first.undoTurn())
+		{
+		}
+		assert(first.getKey() == emptyKey);
+
+		// the player to move is part of the key
+		FourAcross otherFirstPlayer{2, 2};
+		assert(otherFirstPlayer.getKey() != emptyKey);
+	}
+
+	{
+		// mirror images share a canonical key, which is kept up to date as pieces come and go
+		FourAcross game{2, 1, 7, 6};
+		FourAcross mirrored{2, 1, 7, 6};
+		assert(game.getBoard().getKey() == game.getBoard().getMirroredKey());
+		for (auto column : {0, 1, 1, 5, 2})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+			mirrored.takeTurn(mirrored.getCurrentPlayer(), game.getBoard().getMirroredColumn(column));
+		}
+		assert(game.getKey() != mirrored.getKey());
+		assert(game.getBoard().getMirroredKey() == mirrored.getBoard().getKey());
+		assert(game.getCanonicalKey().key == mirrored.getCanonicalKey().key);
+		assert(game.getCanonicalKey().isMirrored != mirrored.getCanonicalKey().isMirrored);
+
+		game.undoTurn();
+		mirrored.undoTurn();
+		assert(game.getBoard().getMirroredKey() == mirrored.getBoard().getKey());
+
+		// symmetric positions aren't mirrored
+		FourAcross symmetric{2, 1, 7, 6};
+		for (auto column : {3, 3, 0, 6})
+		{
+			symmetric.takeTurn(symmetric.getCurrentPlayer(), column);
+		}
+		assert(!symmetric.getCanonicalKey().isMirrored);
+		assert(symmetric.getCanonicalKey().key == symmetric.getKey());
+	}
+
+	{
+		TranspositionTable table{1 << 16};
+		assert(table.getNumEntries() == (1 << 16) / TranspositionTable::bucketSize * TranspositionTable::entriesPerBucket);
+
+		TranspositionTable::Entry entry{};
+		assert(!table.probe(1234, entry));
+		table.store(1234, {-7, 5, TranspositionTable::Bound::lower, 3});
+		assert(table.probe(1234, entry));
+		assert(entry.score == -7 && entry.depth == 5 && entry.bound == TranspositionTable::Bound::lower && entry.bestMove == 3);
+
+		// replacing the same key overwrites it
+		table.store(1234, {9, 2, TranspositionTable::Bound::exact, 1});
+		assert(table.probe(1234, entry));
+		assert(entry.score == 9 && entry.bound == TranspositionTable::Bound::exact);
+
+		table.clear();
+		assert(!table.probe(1234, entry));
+	}
+
+	{
+		// threads storing and probing at once never see an entry stored for another key
+		TranspositionTable table{1 << 12, true};
+		std::cout << "huge pages: " << table.usesHugePages() << "\n";
+
+		std::vector<std::thread> threads;
+		for (int thread = 0; thread < 4; ++thread)
+		{
+			threads.emplace_back([&table, thread]()
+				{
+					for (uint64_t i = 0; i < 200000; ++i)
+					{
+						// the score is derived from the key so any mix-up is detectable
+						const uint64_t key = zobrist::mix(i * 4 + thread);
+						table.store(key, {static_cast<int16_t>(key & 0x7fff), static_cast<uint8_t>(i), TranspositionTable::Bound::exact, 0});
+						TranspositionTable::Entry entry{};
+						const uint64_t otherKey = zobrist::mix((i / 2) * 4 + (thread + 1) % 4);
+						if (table.probe(otherKey, entry))
+						{
+							assert(entry.score == static_cast<int16_t>(otherKey & 0x7fff));
+						}
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+	}
+
+	std::cout << "tests passed\n";
+}
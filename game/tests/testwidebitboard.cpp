@@ -0,0 +1,76 @@
+#include "four-across/game/widebitboard.hpp"
+#include "four-across/game/game.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+
+namespace
+{
+	// Checks shifts against shifting one bit at a time.
+	template<size_t Words>
+	void testShifts(std::default_random_engine& engine)
+	{
+		using bitboard_t = game::WideBitboard<Words>;
+		uint64_t words[Words];
+		for (auto& word : words)
+		{
+			word = (static_cast<uint64_t>(engine()) << 32) | engine();
+		}
+		const auto bitboard = bitboard_t::load(words);
+
+		for (size_t count = 0; count < bitboard_t::numBits; count += 7)
+		{
+			const auto shifted = bitboard.shiftedRight(count);
+			for (size_t bit = 0; bit < bitboard_t::numBits; ++bit)
+			{
+				const bool expected = bit + count < bitboard_t::numBits && bitboard.testBit(bit + count);
+				assert(shifted.testBit(bit) == expected);
+			}
+		}
+
+		bitboard_t empty{};
+		assert(!empty.any());
+		empty.setBit(bitboard_t::numBits - 1);
+		assert(empty.any());
+		assert((empty & bitboard).testBit(bitboard_t::numBits - 1) == bitboard.testBit(bitboard_t::numBits - 1));
+		empty.clearBit(bitboard_t::numBits - 1);
+		assert(!empty.any());
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	std::default_random_engine engine{42};
+	testShifts<2>(engine);
+	testShifts<4>(engine);
+	testShifts<8>(engine);
+
+	{
+		// 16x12 board needs 4 words: win across the word boundary between columns 5 and 6
+		FourAcross game{2, 1, 16, 12};
+		const uint8_t moves[] = {3, 0, 4, 0, 5, 0, 6};
+		for (auto column : moves)
+		{
+			FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), column);
+			assert(result == FourAcross::TurnResult::success);
+		}
+		assert(game.getWinner() == 1);
+	}
+
+	{
+		// 30x20 board is too big for bitboards and uses the grid
+		FourAcross game{2, 1, 30, 20};
+		const uint8_t moves[] = {29, 0, 28, 0, 27, 0, 26};
+		for (auto column : moves)
+		{
+			FourAcross::TurnResult result = game.takeTurn(game.getCurrentPlayer(), column);
+			assert(result == FourAcross::TurnResult::success);
+		}
+		assert(game.getWinner() == 1);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <random>
+
+namespace game
+{
+	// Results of random games played from one position, for the player to move there.
+	struct PlayoutCounts
+	{
+		uint32_t wins;
+		uint32_t losses;
+		uint32_t draws;
+	};
+
+	/*
+		Plays random two player games to the end from many positions at once, for estimating win
+		rates. The games are kept as bitboards in structure of arrays form, one 64-bit lane per game,
+		and numLanes of them advance together: every step each lane drops a piece in a random column
+		(picking again next step if the column is full), then every lane's board is checked for a line
+		at once, and lanes whose game ended start the next game. Picking moves uses AVX2 when the
+		compiler targets it, and the line check uses AVX2 or SSE2, falling back to one lane at a time.
+	*/
+	class BatchPlayout
+	{
+	public:
+		// Prepares the masks of a board with the given settings. Throws std::invalid_argument if the
+		// board has more than 64 cells or the win length is invalid.
+		BatchPlayout(uint8_t numColumns, uint8_t numRows, uint8_t winLength = FourAcross::defaultWinLength);
+
+		// Plays numPlayouts games from each of numPositions positions, setting counts[i] to the results
+		// for positions[i]. Positions that are already over count every game as over. rng seeds the
+		// generators of the lanes. Throws std::invalid_argument if a position doesn't have two players
+		// or has other settings than the BatchPlayout.
+		void playoutBatch(const FourAcross* positions, size_t numPositions, uint32_t numPlayouts,
+			std::mt19937_64& rng, PlayoutCounts* counts) const;
+
+		uint8_t getNumColumns() const noexcept;
+		uint8_t getNumRows() const noexcept;
+		uint8_t getWinLength() const noexcept;
+
+		static constexpr size_t numLanes{16};
+	private:
+		struct Lanes;
+
+		// Drops a piece in a random column of every lane.
+		void makeRandomMoves(Lanes& lanes) const noexcept;
+
+		// Sets lanes.lines to the first cell of every line of the player who just moved in each lane.
+		void findLines(Lanes& lanes) const noexcept;
+
+		uint64_t findLines(uint64_t pieces) const noexcept;
+
+		uint8_t numColumns;
+		uint8_t numRows;
+		uint8_t winLength;
+		uint64_t columnBits; // the cells of column 0
+		uint64_t fullMask;
+		std::array<uint8_t, 4> shifts; // from a cell to the next one up, right, up and right, down and right
+		std::array<uint64_t, 4> neighborMasks; // cells whose next cell in each direction is on the board
+
+		// A line of winLength pieces is found from the pairs of neighbouring pieces by doubling the
+		// length found, each step overlapping the lines found with ones lineSteps[i] cells further on.
+		std::array<uint8_t, 8> lineSteps;
+		uint8_t numLineSteps;
+	};
+
+	inline uint8_t BatchPlayout::getNumColumns() const noexcept
+	{
+		return numColumns;
+	}
+
+	inline uint8_t BatchPlayout::getNumRows() const noexcept
+	{
+		return numRows;
+	}
+
+	inline uint8_t BatchPlayout::getWinLength() const noexcept
+	{
+		return winLength;
+	}
+}
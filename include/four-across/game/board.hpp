@@ -1,5 +1,11 @@
 #pragma once
 
+#include "four-across/game/zobrist.hpp"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <limits>
 #include <string>
 #include <vector>
@@ -11,29 +17,78 @@ namespace game
 	// up to numColumns - 1, numRows - 1 for the top right.
 	class Board
 	{
-		class ColumnView; // allows read operations on a reference to a column
-		class Column; // allows read operations on a copy of a column
+		class LineView; // allows read operations on a line of cells without copying them
 	public:
 
-		using column_view_t = ColumnView;
-		using column_value_t = Column;
+		using line_view_t = LineView;
+		using column_view_t = LineView;
+		using column_value_t = LineView;
+
+		// Outcome of the non-throwing try* operations.
+		enum class Status : uint8_t
+		{
+			success, outOfRange, columnFull, columnEmpty
+		};
 
 		// Constructs a Board; throws std::runtime_exception if numColumns < 7, numRows  < 6, 
 		// or numColumns - numRows < 1
 		Board(uint8_t numColumns = minColumns, uint8_t numRows = minRows);
 
+		Board(const Board& board);
+
 		// Move constructs from existing board: leaves argument in a destructable but unusable state.
 		// Any modifiers or queries that need to access the underlying grid data will throw out_of_range exceptions.
 		Board(Board&& board) noexcept;
 
 		~Board();
 
+		Board& operator=(const Board& board);
+
 		// Move assigns from existing board: see move constructor for usability after move.
 		Board& operator=(Board&& board) noexcept;
 
 		// Attempts to drop a player piece into given column, returning false if column is full.
+		// Throws std::out_of_range for a bad column; see tryDropPieceInColumn.
 		bool dropPieceInColumn(uint8_t column, uint8_t playerNum);
 
+		// Attempts to take the top piece out of given column, returning false if column is empty.
+		// Throws std::out_of_range for a bad column; see tryRemovePieceFromColumn.
+		bool removePieceFromColumn(uint8_t column);
+
+		/*
+			Non-throwing versions of the checked operations, for untrusted input. Bad indices give
+			Status::outOfRange instead of an exception, and out parameters are only written on success.
+		*/
+		Status tryDropPieceInColumn(uint8_t column, uint8_t playerNum) noexcept;
+		Status tryRemovePieceFromColumn(uint8_t column) noexcept;
+		Status tryIsColumnFull(uint8_t column, bool& isColumnFull) const noexcept;
+		Status tryGetDiskOwnerAt(uint8_t column, uint8_t row, uint8_t& owner) const noexcept;
+		Status tryGetColumnHeight(uint8_t column, uint8_t& height) const noexcept;
+
+		// Drops a player piece into given column without checks: column must be in range and not full.
+		void pushPiece(uint8_t column, uint8_t playerNum) noexcept;
+
+		// Takes the top piece out of given column without checks: column must be in range and not empty.
+		void popPiece(uint8_t column) noexcept;
+
+		/*
+			Unchecked versions of the accessors, for cells already known to be on the board such as
+			those of a move just played: column and row must be in range.
+		*/
+		uint8_t getDiskOwnerAtUnchecked(uint8_t column, uint8_t row) const noexcept;
+		uint8_t getColumnHeightUnchecked(uint8_t column) const noexcept;
+		column_view_t getColumnUnchecked(uint8_t column) const noexcept;
+		column_value_t getRowUnchecked(uint8_t row) const noexcept;
+		line_view_t getDiagonalUnchecked(uint8_t column, uint8_t row) const noexcept;
+		line_view_t getAntiDiagonalUnchecked(uint8_t column, uint8_t row) const noexcept;
+
+		// Copies the owner of every cell, column by column (index = column * numRows + row), to cells.
+		void copyCellsTo(uint8_t* cells) const noexcept;
+
+		// Replaces the pieces on the board with numColumns * numRows cells laid out as in copyCellsTo.
+		// Every column must be filled from the bottom without gaps.
+		void assignCells(const uint8_t* cells) noexcept;
+
 		// Returns true if entire board is full.
 		bool isFull() const noexcept;
 
@@ -52,9 +107,38 @@ namespace game
 		// Gets a view of an entire row of the board.
 		column_value_t getRow(uint8_t row) const;
 
+		// Gets a view of the diagonal running up and to the right through column, row. The view
+		// starts at the bottom left end of the diagonal, so column, row is at index min(column, row).
+		line_view_t getDiagonal(uint8_t column, uint8_t row) const;
+
+		// Gets a view of the diagonal running down and to the right through column, row. The view
+		// starts at the top left end of the diagonal, so column, row is at index min(column, numRows - 1 - row).
+		line_view_t getAntiDiagonal(uint8_t column, uint8_t row) const;
+
 		uint8_t getNumColumns() const noexcept;
 		uint8_t getNumRows() const noexcept;
 
+		// Returns the Zobrist key of the pieces on the board: see zobrist::getPieceKey.
+		uint64_t getKey() const noexcept;
+
+		// Returns the Zobrist key of the board mirrored left to right, kept up to date with getKey.
+		uint64_t getMirroredKey() const noexcept;
+
+		// Returns the smaller of getKey and getMirroredKey: see zobrist::getCanonicalKey.
+		zobrist::CanonicalKey getCanonicalKey() const noexcept;
+
+		// Returns the column that column becomes when the board is mirrored left to right.
+		uint8_t getMirroredColumn(uint8_t column) const noexcept;
+
+		// Returns true if the board is also tracked with bitboards. This is the case when
+		// numColumns * numRows <= maxWideBitboardCells and only players 1 to maxBitboardPlayers have dropped pieces.
+		// Boards with up to maxBitboardCells cells use single 64-bit words, larger ones use WideBitboards.
+		bool hasBitboard() const noexcept;
+
+		// Returns true if the player has length pieces in a line anywhere on the board; length must be at least 2.
+		// Lengths 3 to 6 use checks specialized at compile time. Only valid when hasBitboard() is true.
+		bool hasLineOfLength(uint8_t playerNum, uint8_t length) const noexcept;
+
 		operator std::string() const;
 
 		// Nonplayer value of grid slots.
@@ -63,15 +147,67 @@ namespace game
 		// Minimum allowed value for column and row.
 		static constexpr uint8_t minColumns{5};
 		static constexpr uint8_t minRows{4};
+
+		// Limits for tracking the board with bitboards.
+		static constexpr uint8_t maxBitboardCells{64};
+		static constexpr uint16_t maxWideBitboardCells{512};
+		static constexpr uint8_t maxBitboardPlayers{4};
 	private:
-		using column_t = std::vector<uint8_t>;
-		using grid_t = std::vector<column_t>;
+		using grid_t = std::vector<uint8_t>;
+		using bitboard_t = uint64_t;
+		using win_kernel_t = bool (*)(bitboard_t);
+
+		// Line directions, indexing neighborMasks.
+		enum Direction : uint8_t
+		{
+			vertical, horizontal, diagonal, antiDiagonal, numDirections
+		};
 
 		uint8_t numColumns;
 		uint8_t numRows;
 
-		grid_t columns;
-		std::vector<uint8_t> rowIndices;
+		// Cells column by column (index = column * numRows + row), followed by the height of each column.
+		grid_t grid;
+
+		// Number of pieces on the board.
+		uint16_t numPieces;
+
+		// XOR of the Zobrist key of every piece on the board, and of every piece of the mirrored board.
+		uint64_t key;
+		uint64_t mirroredKey;
+
+		// Bitboards store one bit per cell, column by column (bit = column * numRows + row).
+		bool useBitboard;
+		bitboard_t occupiedMask; // height mask: set for every cell holding a piece
+		std::array<bitboard_t, maxBitboardPlayers> playerMasks;
+		std::array<bitboard_t, numDirections> neighborMasks; // cells whose next cell in a direction is on the board
+		win_kernel_t fourInARowKernel; // FixedBoard line check for the common sizes, or nullptr
+
+		// Boards too big for one word keep their bitboards in wideMasks: the occupied mask, the mask of each
+		// player and then the neighbor masks, each wideWords words long. wideWords is 0 if there are none.
+		uint8_t wideWords;
+		std::vector<uint64_t> wideMasks;
+
+		void initBitboard();
+		void initWideBitboard(uint16_t numCells);
+
+		// Returns the number of words in each wide bitboard for a board of numCells cells, or 0 if it's too big.
+		static uint8_t getNumWideWords(uint16_t numCells) noexcept;
+
+		template<size_t Words>
+		bool containsWideLine(uint8_t playerNum, uint8_t length) const noexcept;
+
+		uint64_t* getWideMask(uint8_t index) noexcept;
+		const uint64_t* getWideMask(uint8_t index) const noexcept;
+
+		bitboard_t getCellBit(uint8_t column, uint8_t row) const noexcept;
+		bitboard_t getColumnMask(uint8_t column) const noexcept;
+		uint8_t getDirectionShift(Direction direction) const noexcept;
+
+		uint8_t& cellAt(uint8_t column, uint8_t row) noexcept;
+		const uint8_t& cellAt(uint8_t column, uint8_t row) const noexcept;
+		uint8_t& heightOf(uint8_t column) noexcept;
+		uint8_t heightOf(uint8_t column) const noexcept;
 
 		bool isColumnFullInternal(uint8_t column) const noexcept;
 
@@ -89,29 +225,157 @@ namespace game
 		return numRows;
 	}
 
-	class Board::ColumnView
+	inline uint64_t Board::getKey() const noexcept
 	{
-		friend class Board;
-	public:
-		column_t::const_iterator begin() const noexcept;
-		column_t::const_iterator end() const noexcept;
-		column_t::value_type operator[](uint8_t index) const;
-	private:
-		explicit ColumnView(const column_t& column);
-		const column_t& column;
-	};
+		return key;
+	}
+
+	inline uint64_t Board::getMirroredKey() const noexcept
+	{
+		return mirroredKey;
+	}
+
+	inline zobrist::CanonicalKey Board::getCanonicalKey() const noexcept
+	{
+		return zobrist::getCanonicalKey(key, mirroredKey);
+	}
+
+	inline uint8_t Board::getMirroredColumn(uint8_t column) const noexcept
+	{
+		return numColumns - 1 - column;
+	}
+
+	inline bool Board::hasBitboard() const noexcept
+	{
+		return useBitboard || wideWords != 0;
+	}
+
+	inline uint8_t& Board::cellAt(uint8_t column, uint8_t row) noexcept
+	{
+		return grid[column * numRows + row];
+	}
+
+	inline const uint8_t& Board::cellAt(uint8_t column, uint8_t row) const noexcept
+	{
+		return grid[column * numRows + row];
+	}
+
+	inline uint8_t& Board::heightOf(uint8_t column) noexcept
+	{
+		return grid[numColumns * numRows + column];
+	}
+
+	inline uint8_t Board::heightOf(uint8_t column) const noexcept
+	{
+		return grid[numColumns * numRows + column];
+	}
+
+	inline uint8_t Board::getColumnHeightUnchecked(uint8_t column) const noexcept
+	{
+		return heightOf(column);
+	}
 
-	class Board::Column
+	// Non-owning view of evenly spaced cells in the board's grid. Views are invalidated
+	// when the board is moved or destroyed.
+	class Board::LineView
 	{
 		friend class Board;
 	public:
-		column_t::const_iterator begin() const noexcept;
-		column_t::const_iterator end() const noexcept;
-		column_t::value_type operator[](uint8_t index) const;
+		class const_iterator
+		{
+			friend class LineView;
+		public:
+			using iterator_category = std::forward_iterator_tag;
+			using value_type = uint8_t;
+			using difference_type = std::ptrdiff_t;
+			using pointer = const uint8_t*;
+			using reference = const uint8_t&;
+
+			reference operator*() const noexcept;
+			const_iterator& operator++() noexcept;
+			const_iterator operator++(int) noexcept;
+			bool operator==(const const_iterator& other) const noexcept;
+			bool operator!=(const const_iterator& other) const noexcept;
+		private:
+			const_iterator(pointer cell, std::size_t stride) noexcept;
+			pointer cell;
+			std::size_t stride;
+		};
+
+		const_iterator begin() const noexcept;
+		const_iterator end() const noexcept;
+
+		// Gets the cell at index; does not check bounds.
+		uint8_t operator[](std::size_t index) const noexcept;
+
+		std::size_t size() const noexcept;
 	private:
-		explicit Column(column_t&& column);
-		column_t column;
+		LineView(const uint8_t* first, std::size_t stride, std::size_t length) noexcept;
+		const uint8_t* first;
+		std::size_t stride;
+		std::size_t length;
 	};
+
+	inline Board::LineView::LineView(const uint8_t* first, std::size_t stride, std::size_t length) noexcept :
+		first{first},
+		stride{stride},
+		length{length}
+	{
+	}
+
+	inline Board::LineView::const_iterator Board::LineView::begin() const noexcept
+	{
+		return const_iterator{first, stride};
+	}
+
+	inline Board::LineView::const_iterator Board::LineView::end() const noexcept
+	{
+		return const_iterator{first + length * stride, stride};
+	}
+
+	inline uint8_t Board::LineView::operator[](std::size_t index) const noexcept
+	{
+		return first[index * stride];
+	}
+
+	inline std::size_t Board::LineView::size() const noexcept
+	{
+		return length;
+	}
+
+	inline Board::LineView::const_iterator::const_iterator(pointer cell, std::size_t stride) noexcept :
+		cell{cell},
+		stride{stride}
+	{
+	}
+
+	inline Board::LineView::const_iterator::reference Board::LineView::const_iterator::operator*() const noexcept
+	{
+		return *cell;
+	}
+
+	inline Board::LineView::const_iterator& Board::LineView::const_iterator::operator++() noexcept
+	{
+		cell += stride;
+		return *this;
+	}
+
+	inline Board::LineView::const_iterator Board::LineView::const_iterator::operator++(int) noexcept
+	{
+		const_iterator previous{*this};
+		cell += stride;
+		return previous;
+	}
+
+	inline bool Board::LineView::const_iterator::operator==(const const_iterator& other) const noexcept
+	{
+		return cell == other.cell;
+	}
+
+	inline bool Board::LineView::const_iterator::operator!=(const const_iterator& other) const noexcept
+	{
+		return cell != other.cell;
+	}
 }
 
 inline std::ostream& operator<<(std::ostream& out, const game::Board& board)
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace game
+{
+	/*
+		Fixed size set of Zobrist keys (see FourAcross::getKey) that threads can add to at the same
+		time without locks. Keys are kept in one open addressed array, probed linearly from the slot
+		picked by the key's low bits, and claimed with a compare and swap. Zero marks empty slots,
+		so a zero key is tracked on its own.
+	*/
+	class ConcurrentKeySet
+	{
+	public:
+		enum class InsertResult : uint8_t
+		{
+			inserted, alreadyPresent, full
+		};
+
+		// Makes a set that holds up to capacity keys, with twice as many slots to keep probes short.
+		explicit ConcurrentKeySet(size_t capacity);
+
+		ConcurrentKeySet(const ConcurrentKeySet&) = delete;
+
+		ConcurrentKeySet& operator=(const ConcurrentKeySet&) = delete;
+
+		// Adds key to the set, unless it's already there or the set holds capacity keys.
+		InsertResult insert(uint64_t key) noexcept;
+
+		bool contains(uint64_t key) const noexcept;
+
+		// Removes every key. Must not be called while other threads use the set.
+		void clear() noexcept;
+
+		size_t getNumKeys() const noexcept;
+		size_t getCapacity() const noexcept;
+	private:
+		std::unique_ptr<std::atomic<uint64_t>[]> slots;
+		size_t slotMask; // number of slots less 1, a power of two less 1
+		size_t capacity;
+		std::atomic<size_t> numKeys;
+		std::atomic<bool> hasZeroKey;
+	};
+
+	inline size_t ConcurrentKeySet::getNumKeys() const noexcept
+	{
+		return numKeys.load(std::memory_order_relaxed);
+	}
+
+	inline size_t ConcurrentKeySet::getCapacity() const noexcept
+	{
+		return capacity;
+	}
+}
@@ -0,0 +1,279 @@
+#pragma once
+
+#include "four-across/game/board.hpp"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+
+namespace game
+{
+	namespace detail
+	{
+		// Bitboard tables for a board with dimensions known at compile time. Cells are laid out
+		// like Board's bitboards (bit = column * Rows + row).
+		template<uint8_t Cols, uint8_t Rows>
+		struct FixedBoardTables
+		{
+			static constexpr uint8_t numCells{Cols * Rows};
+
+			uint8_t cellOffsets[Cols][Rows];
+			uint64_t columnMasks[Cols];
+
+			// For vertical, horizontal, diagonal (up-right) and anti-diagonal (down-right) lines:
+			// the bit distance to the next cell, and the cells whose next cell is on the board.
+			uint8_t directionShifts[4];
+			uint64_t neighborMasks[4];
+		};
+
+		template<uint8_t Cols, uint8_t Rows>
+		constexpr FixedBoardTables<Cols, Rows> makeFixedBoardTables()
+		{
+			constexpr int columnSteps[4]{0, 1, 1, 1};
+			constexpr int rowSteps[4]{1, 0, 1, -1};
+
+			FixedBoardTables<Cols, Rows> tables{};
+			tables.directionShifts[0] = 1;
+			tables.directionShifts[1] = Rows;
+			tables.directionShifts[2] = Rows + 1;
+			tables.directionShifts[3] = Rows - 1;
+
+			for (int col = 0; col < Cols; ++col)
+			{
+				for (int row = 0; row < Rows; ++row)
+				{
+					const uint8_t offset = static_cast<uint8_t>(col * Rows + row);
+					const uint64_t cell = uint64_t{1} << offset;
+					tables.cellOffsets[col][row] = offset;
+					tables.columnMasks[col] |= cell;
+
+					for (int direction = 0; direction < 4; ++direction)
+					{
+						const int nextCol = col + columnSteps[direction];
+						const int nextRow = row + rowSteps[direction];
+						if (nextCol < Cols && nextRow >= 0 && nextRow < Rows)
+						{
+							tables.neighborMasks[direction] |= cell;
+						}
+					}
+				}
+			}
+			return tables;
+		}
+
+		template<uint8_t Cols, uint8_t Rows>
+		struct BoardSize
+		{
+			static constexpr uint8_t numColumns{Cols};
+			static constexpr uint8_t numRows{Rows};
+		};
+
+		template<typename... Sizes>
+		struct BoardSizeList
+		{
+		};
+
+		// Board sizes that get a FixedBoard specialization when created at runtime.
+		using fixed_board_sizes_t = BoardSizeList<
+			BoardSize<5, 4>,
+			BoardSize<6, 5>,
+			BoardSize<7, 6>,
+			BoardSize<8, 7>,
+			BoardSize<9, 7>>;
+
+		template<typename Fallback, typename Visitor>
+		auto dispatchBoardSize(uint8_t, uint8_t, BoardSizeList<>, Fallback&& fallback, Visitor&&) -> decltype(fallback())
+		{
+			return fallback();
+		}
+
+		// Calls visitor with the BoardSize matching the dimensions, or fallback if there is no match.
+		template<typename Size, typename... Sizes, typename Fallback, typename Visitor>
+		auto dispatchBoardSize(
+			uint8_t numColumns,
+			uint8_t numRows,
+			BoardSizeList<Size, Sizes...>,
+			Fallback&& fallback,
+			Visitor&& visitor) -> decltype(fallback())
+		{
+			if (numColumns == Size::numColumns && numRows == Size::numRows)
+			{
+				return visitor(Size{});
+			}
+			return dispatchBoardSize(numColumns, numRows, BoardSizeList<Sizes...>{},
+				std::forward<Fallback>(fallback), std::forward<Visitor>(visitor));
+		}
+	}
+
+	/*
+		Game board with dimensions fixed at compile time. Behaves like a Board limited to
+		Board::maxBitboardPlayers players, but bounds, cell offsets and the shifts of the win check are constants.
+	*/
+	template<uint8_t Cols, uint8_t Rows>
+	class FixedBoard
+	{
+		static_assert(Cols >= Board::minColumns && Rows >= Board::minRows && Cols - Rows >= 1,
+			"FixedBoard: invalid board dimensions");
+		static_assert(Cols * Rows <= Board::maxBitboardCells,
+			"FixedBoard: board does not fit in a bitboard");
+	public:
+		using tables_t = detail::FixedBoardTables<Cols, Rows>;
+
+		FixedBoard() noexcept;
+
+		// Attempts to drop a player piece into given column, returning false if column is full.
+		// Throws std::out_of_range if column or playerNum is invalid.
+		bool dropPieceInColumn(uint8_t column, uint8_t playerNum);
+
+		// Returns true if entire board is full.
+		bool isFull() const noexcept;
+
+		// Returns true if column is full.
+		bool isColumnFull(uint8_t column) const;
+
+		// Gets the owner of the piece at given column, row. Returns Board::emptySlot if slot is empty.
+		uint8_t getDiskOwnerAt(uint8_t column, uint8_t row) const;
+
+		// Get the height of a column (number of pieces in it)
+		uint8_t getColumnHeight(uint8_t column) const;
+
+		// Returns true if the player has four pieces in a line anywhere on the board.
+		bool hasFourInARow(uint8_t playerNum) const noexcept;
+
+		// Returns the bitboard of a player's pieces.
+		uint64_t getPlayerMask(uint8_t playerNum) const noexcept;
+
+		// Returns true if the bitboard has four cells in a line.
+		static bool containsFourInARow(uint64_t pieces) noexcept;
+
+		static constexpr uint8_t getNumColumns() noexcept;
+		static constexpr uint8_t getNumRows() noexcept;
+
+		static constexpr tables_t tables{detail::makeFixedBoardTables<Cols, Rows>()};
+	private:
+		static constexpr uint64_t linesAlong(uint64_t pieces, uint8_t direction) noexcept;
+
+		uint64_t occupiedMask;
+		std::array<uint64_t, Board::maxBitboardPlayers> playerMasks;
+		std::array<uint8_t, Cols> heights;
+	};
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr typename FixedBoard<Cols, Rows>::tables_t FixedBoard<Cols, Rows>::tables;
+
+	template<uint8_t Cols, uint8_t Rows>
+	FixedBoard<Cols, Rows>::FixedBoard() noexcept :
+		occupiedMask{0},
+		playerMasks{},
+		heights{}
+	{
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	bool FixedBoard<Cols, Rows>::dropPieceInColumn(uint8_t column, uint8_t playerNum)
+	{
+		if (column >= Cols)
+		{
+			throw std::out_of_range("FixedBoard::dropPieceInColumn: index out of range");
+		}
+		if (playerNum == Board::emptySlot || playerNum > Board::maxBitboardPlayers)
+		{
+			throw std::out_of_range("FixedBoard::dropPieceInColumn: player out of range");
+		}
+
+		if (heights[column] == Rows)
+		{
+			return false;
+		}
+
+		const uint64_t piece = uint64_t{1} << (tables.cellOffsets[column][0] + heights[column]++);
+		occupiedMask |= piece;
+		playerMasks[playerNum - 1] |= piece;
+		return true;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedBoard<Cols, Rows>::isFull() const noexcept
+	{
+		constexpr uint64_t fullMask{tables_t::numCells == Board::maxBitboardCells ?
+			~uint64_t{0} : (uint64_t{1} << tables_t::numCells) - 1};
+		return occupiedMask == fullMask;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedBoard<Cols, Rows>::isColumnFull(uint8_t column) const
+	{
+		return getColumnHeight(column) == Rows;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	uint8_t FixedBoard<Cols, Rows>::getDiskOwnerAt(uint8_t column, uint8_t row) const
+	{
+		if (column >= Cols || row >= Rows)
+		{
+			throw std::out_of_range("FixedBoard::getDiskOwnerAt: index out of range");
+		}
+
+		const uint64_t cell = uint64_t{1} << tables.cellOffsets[column][row];
+		for (uint8_t player = 0; player < Board::maxBitboardPlayers; ++player)
+		{
+			if (playerMasks[player] & cell)
+			{
+				return player + 1;
+			}
+		}
+		return Board::emptySlot;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint8_t FixedBoard<Cols, Rows>::getColumnHeight(uint8_t column) const
+	{
+		if (column >= Cols)
+		{
+			throw std::out_of_range("FixedBoard::getColumnHeight: index out of range");
+		}
+		return heights[column];
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedBoard<Cols, Rows>::hasFourInARow(uint8_t playerNum) const noexcept
+	{
+		return containsFourInARow(getPlayerMask(playerNum));
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint64_t FixedBoard<Cols, Rows>::getPlayerMask(uint8_t playerNum) const noexcept
+	{
+		return playerMasks[playerNum - 1];
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedBoard<Cols, Rows>::containsFourInARow(uint64_t pieces) noexcept
+	{
+		// shifts and masks are all constants, so this compiles down to straight-line code
+		return (linesAlong(pieces, 0) | linesAlong(pieces, 1) | linesAlong(pieces, 2) | linesAlong(pieces, 3)) != 0;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr uint8_t FixedBoard<Cols, Rows>::getNumColumns() noexcept
+	{
+		return Cols;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr uint8_t FixedBoard<Cols, Rows>::getNumRows() noexcept
+	{
+		return Rows;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr uint64_t FixedBoard<Cols, Rows>::linesAlong(uint64_t pieces, uint8_t direction) noexcept
+	{
+		// pairs has a bit set for each piece whose next cell in the direction is also the player's,
+		// so three consecutive pairs make a line of four
+		const uint8_t shift = tables.directionShifts[direction];
+		const uint64_t pairs = pieces & (pieces >> shift) & tables.neighborMasks[direction];
+		return pairs & (pairs >> shift) & (pairs >> (2 * shift));
+	}
+}
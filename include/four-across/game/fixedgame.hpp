@@ -0,0 +1,199 @@
+#pragma once
+
+#include "four-across/game/fixedboard.hpp"
+#include "four-across/game/game.hpp"
+
+#include <stdexcept>
+#include <utility>
+
+namespace game
+{
+	/*
+		FourAcross game played on a FixedBoard. Supports up to Board::maxBitboardPlayers players, and
+		lines of FourAcross::defaultWinLength win.
+	*/
+	template<uint8_t Cols, uint8_t Rows>
+	class FixedFourAcross
+	{
+	public:
+		using TurnResult = FourAcross::TurnResult;
+		using board_t = FixedBoard<Cols, Rows>;
+
+		// Constructs a FixedFourAcross; throws std::invalid_argument if numPlayers > Board::maxBitboardPlayers.
+		FixedFourAcross(
+			uint8_t numPlayers = FourAcross::minNumPlayers,
+			uint8_t firstPlayer = FourAcross::defaultFirstPlayer);
+
+		// Takes a player's turn in the given column. Returns TurnResult::success
+		// on a valid move.
+		TurnResult takeTurn(uint8_t player, uint8_t column) noexcept;
+
+		bool hasWinner() const noexcept;
+		bool boardFull() const noexcept;
+
+		uint8_t getWinner() const noexcept;
+
+		// Returns the id of the player who is taking their turn now.
+		uint8_t getCurrentPlayer() const noexcept;
+
+		uint8_t getNumPlayers() const noexcept;
+		uint32_t getNumTurns() const noexcept;
+
+		static constexpr uint8_t getNumColumns() noexcept;
+		static constexpr uint8_t getNumRows() noexcept;
+
+		const board_t& getBoard() const noexcept;
+	private:
+		uint8_t getNextPlayer() const noexcept;
+
+		uint32_t numTurns;
+		uint8_t numPlayers;
+		uint8_t currentPlayer;
+		uint8_t winner;
+		board_t board;
+	};
+
+	// Creates a game with the given settings and passes it to visitor. Boards with one of the
+	// detail::fixed_board_sizes_t dimensions (with few enough players and the default win length) get a FixedFourAcross
+	// specialization, every other game gets a FourAcross. Returns the visitor's result.
+	template<typename Visitor>
+	auto visitFourAcross(
+		Visitor&& visitor,
+		uint8_t numPlayers = FourAcross::minNumPlayers,
+		uint8_t firstPlayer = FourAcross::defaultFirstPlayer,
+		uint8_t numColumns = Board::minColumns,
+		uint8_t numRows = Board::minRows,
+		uint8_t winLength = FourAcross::defaultWinLength)
+	{
+		auto makeGeneric = [&]()
+		{
+			FourAcross game{numPlayers, firstPlayer, numColumns, numRows, winLength};
+			return visitor(game);
+		};
+
+		if (numPlayers > Board::maxBitboardPlayers || winLength != FourAcross::defaultWinLength)
+		{
+			return makeGeneric();
+		}
+
+		return detail::dispatchBoardSize(numColumns, numRows, detail::fixed_board_sizes_t{},
+			makeGeneric,
+			[&](auto size)
+			{
+				using dimensions_t = decltype(size);
+				FixedFourAcross<dimensions_t::numColumns, dimensions_t::numRows> game{numPlayers, firstPlayer};
+				return visitor(game);
+			});
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	FixedFourAcross<Cols, Rows>::FixedFourAcross(uint8_t numPlayers, uint8_t firstPlayer) :
+		numTurns{0},
+		numPlayers{numPlayers >= FourAcross::minNumPlayers ? numPlayers : FourAcross::minNumPlayers},
+		currentPlayer{firstPlayer > FourAcross::defaultFirstPlayer && firstPlayer <= numPlayers ?
+			firstPlayer : FourAcross::defaultFirstPlayer},
+		winner{FourAcross::noWinner},
+		board{}
+	{
+		if (numPlayers > Board::maxBitboardPlayers)
+		{
+			throw std::invalid_argument("FixedFourAcross::FixedFourAcross: too many players");
+		}
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	typename FixedFourAcross<Cols, Rows>::TurnResult FixedFourAcross<Cols, Rows>::takeTurn(uint8_t player, uint8_t column) noexcept
+	{
+		if (winner != FourAcross::noWinner)
+		{
+			return TurnResult::gameFinished;
+		}
+
+		if (currentPlayer != player)
+		{
+			return TurnResult::wrongPlayer;
+		}
+
+		// the bound is a constant, so there's no need to go through the board's exception
+		if (column >= Cols)
+		{
+			return TurnResult::badColumn;
+		}
+
+		if (!board.dropPieceInColumn(column, player))
+		{
+			return TurnResult::columnFull;
+		}
+
+		currentPlayer = getNextPlayer();
+		++numTurns;
+		winner = board.hasFourInARow(player) ? player : FourAcross::noWinner;
+
+		return TurnResult::success;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedFourAcross<Cols, Rows>::hasWinner() const noexcept
+	{
+		return winner != FourAcross::noWinner;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline bool FixedFourAcross<Cols, Rows>::boardFull() const noexcept
+	{
+		return board.isFull();
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint8_t FixedFourAcross<Cols, Rows>::getWinner() const noexcept
+	{
+		return winner;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint8_t FixedFourAcross<Cols, Rows>::getCurrentPlayer() const noexcept
+	{
+		return currentPlayer;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint8_t FixedFourAcross<Cols, Rows>::getNumPlayers() const noexcept
+	{
+		return numPlayers;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint32_t FixedFourAcross<Cols, Rows>::getNumTurns() const noexcept
+	{
+		return numTurns;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr uint8_t FixedFourAcross<Cols, Rows>::getNumColumns() noexcept
+	{
+		return Cols;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	constexpr uint8_t FixedFourAcross<Cols, Rows>::getNumRows() noexcept
+	{
+		return Rows;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline const typename FixedFourAcross<Cols, Rows>::board_t& FixedFourAcross<Cols, Rows>::getBoard() const noexcept
+	{
+		return board;
+	}
+
+	template<uint8_t Cols, uint8_t Rows>
+	inline uint8_t FixedFourAcross<Cols, Rows>::getNextPlayer() const noexcept
+	{
+		uint8_t nextPlayer = currentPlayer + 1;
+		if (nextPlayer > numPlayers)
+		{
+			nextPlayer = FourAcross::defaultFirstPlayer; // wrap around
+		}
+		return nextPlayer;
+	}
+}
@@ -1,9 +1,13 @@
 #pragma once
 
 #include "four-across/game/board.hpp"
+#include "four-across/game/linecounters.hpp"
+#include "four-across/game/snapshot.hpp"
+#include "four-across/game/zobrist.hpp"
 
 #include <string>
 #include <utility>
+#include <vector>
 
 namespace game
 {
@@ -14,20 +18,50 @@ namespace game
 	{
 	public:
 		enum class TurnResult : uint8_t;
+		enum class WinDetection : uint8_t;
 
 		FourAcross(
 			uint8_t numPlayers = minNumPlayers,
 			uint8_t firstPlayer = defaultFirstPlayer,
 			uint8_t numColumns = Board::minColumns,
-			uint8_t numRows = Board::minRows);
+			uint8_t numRows = Board::minRows,
+			uint8_t winLength = defaultWinLength,
+			WinDetection winDetection = defaultWinDetection);
+
+		// Constructs a game in the state saved in snapshot; see restore.
+		explicit FourAcross(const GameSnapshot& snapshot);
+
+		// Copies the game, including its move history, so the copy can be played and undone on its own.
+		FourAcross(const FourAcross& connect);
 		FourAcross(FourAcross&& connect) noexcept;
 		~FourAcross();
 
+		FourAcross& operator=(const FourAcross& connect);
 		FourAcross& operator=(FourAcross&& connect) noexcept;
 
 		// Takes a player's turn in the given column. Returns TurnResult::success
-		// on a valid move.
-		TurnResult takeTurn(uint8_t player, uint8_t column);
+		// on a valid move. Invalid moves are reported through the result only.
+		TurnResult takeTurn(uint8_t player, uint8_t column) noexcept;
+
+		// Takes back the last turn, returning false if no turns have been taken.
+		bool undoTurn();
+
+		// Plays the current player's piece in the given column without any checks, for searches and replays:
+		// the game must not have a winner and column must be in range and not full.
+		void makeMove(uint8_t column) noexcept;
+
+		// Takes back the last move without any checks: at least one turn must have been taken.
+		void unmakeMove() noexcept;
+
+		// Returns a copy of the game's state. Throws std::length_error if the board has more than
+		// GameSnapshot::maxCells cells.
+		GameSnapshot snapshot() const;
+
+		// Replaces the game's state with the one saved in snapshot. Reuses the game's memory when the
+		// settings match, so restoring positions of one game doesn't allocate unless win detection is
+		// incremental. Throws std::invalid_argument if the snapshot's settings or players are invalid, or its
+		// cells don't hold exactly the pieces of its moves.
+		void restore(const GameSnapshot& snapshot);
 
 		bool hasWinner() const noexcept;
 		bool boardFull() const noexcept;
@@ -40,9 +74,25 @@ namespace game
 		uint8_t getNumPlayers() const noexcept;
 		uint32_t getNumTurns() const noexcept;
 
+		// Returns the column of every move taken, in order.
+		const std::vector<uint8_t>& getMoves() const noexcept;
+
 		uint8_t getNumColumns() const noexcept;
 		uint8_t getNumRows() const noexcept;
 
+		// Returns the number of pieces a player needs in a line to win.
+		uint8_t getWinLength() const noexcept;
+
+		WinDetection getWinDetection() const noexcept;
+
+		// Returns the Zobrist key of the position: the board's key combined with the player to move.
+		uint64_t getKey() const noexcept;
+
+		// Returns the smaller of getKey and the key of the mirrored position: see zobrist::getCanonicalKey.
+		zobrist::CanonicalKey getCanonicalKey() const noexcept;
+
+		const Board& getBoard() const noexcept;
+
 		// Returns a representation of the game as a Board string (showing all moves taken),
 		// the current player, the next player, the number of turns taken, and the winner (if
 		// there is one).
@@ -51,8 +101,18 @@ namespace game
 		static constexpr uint8_t noWinner{Board::emptySlot};
 		static constexpr uint8_t defaultFirstPlayer{1};
 		static constexpr uint8_t minNumPlayers{2};
+		static constexpr uint8_t minWinLength{2};
+		static constexpr uint8_t defaultWinLength{4};
+		static const WinDetection defaultWinDetection;
 	private:
-		uint8_t checkForWinner() const;
+		// Returns the player who made the last move if it completed a line, otherwise noWinner.
+		uint8_t checkForWinner() const noexcept;
+
+		// Records the move the current player just made in column and passes the turn on.
+		void finishMove(uint8_t column) noexcept;
+
+		// Returns the number of consecutive pieces owned by player in line that include the one at index.
+		static size_t countRun(const Board::line_view_t& line, size_t index, uint8_t player) noexcept;
 		uint8_t getNextPlayer() const noexcept;
 
 		uint32_t numTurns;
@@ -60,7 +120,13 @@ namespace game
 		uint8_t currentPlayer;
 		std::pair<uint8_t, uint8_t> lastMove;
 		uint8_t winner;
+		uint8_t winLength;
+		WinDetection winDetection;
 		Board board;
+		LineCounters lineCounters;
+
+		// Column of every move taken, in order. Reserved for a full board up front so recording a move never allocates.
+		std::vector<uint8_t> moveHistory;
 	};
 
 	enum class FourAcross::TurnResult : uint8_t
@@ -68,6 +134,18 @@ namespace game
 		error, success, wrongPlayer, badColumn, columnFull, gameFinished
 	};
 
+	// How FourAcross detects that the last move won.
+	enum class FourAcross::WinDetection : uint8_t
+	{
+		// Check the board's bitboards if it has them, otherwise scan the lines through the last move.
+		automatic,
+		// Always scan the lines through the last move.
+		scan,
+		// Keep run lengths for every cell up to date as pieces are dropped, so each check is
+		// constant time on any board size, at the cost of 5 bytes of memory per cell.
+		incremental
+	};
+
 
 	inline bool FourAcross::hasWinner() const noexcept
 	{
@@ -99,6 +177,11 @@ namespace game
 		return numTurns;
 	}
 
+	inline const std::vector<uint8_t>& FourAcross::getMoves() const noexcept
+	{
+		return moveHistory;
+	}
+
 	inline uint8_t game::FourAcross::getNumColumns() const noexcept
 	{
 		return board.getNumColumns();
@@ -108,6 +191,32 @@ namespace game
 	{
 		return board.getNumRows();
 	}
+
+	inline uint8_t FourAcross::getWinLength() const noexcept
+	{
+		return winLength;
+	}
+
+	inline FourAcross::WinDetection FourAcross::getWinDetection() const noexcept
+	{
+		return winDetection;
+	}
+
+	inline const Board& FourAcross::getBoard() const noexcept
+	{
+		return board;
+	}
+
+	inline uint64_t FourAcross::getKey() const noexcept
+	{
+		return board.getKey() ^ zobrist::getPlayerToMoveKey(currentPlayer);
+	}
+
+	inline zobrist::CanonicalKey FourAcross::getCanonicalKey() const noexcept
+	{
+		const uint64_t playerKey = zobrist::getPlayerToMoveKey(currentPlayer);
+		return zobrist::getCanonicalKey(board.getKey() ^ playerKey, board.getMirroredKey() ^ playerKey);
+	}
 }
 
 inline std::ostream& operator<<(std::ostream& out, const game::FourAcross& FourAcross)
@@ -0,0 +1,101 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace game
+{
+	// Settings and length of a recorded game.
+	struct GameRecordHeader
+	{
+		uint8_t numColumns;
+		uint8_t numRows;
+		uint8_t winLength;
+		uint8_t numPlayers;
+		uint8_t firstPlayer;
+		uint16_t numMoves;
+	};
+
+	/*
+		Writes a game as a compact binary record: a header of headerSize bytes (the number of columns,
+		rows and win length, the number of players in the high 4 bits and first player in the low 4
+		bits of one byte, then the number of moves as 16 bits, low byte first), then the columns of
+		the moves packed 4 bits each, the first move in the low bits of its byte. A 7x6 game takes at
+		most 27 bytes. Only boards of up to 16 columns and games of up to 15 players can be recorded.
+
+		Moves are added one at a time into a buffer the caller owns, so recording doesn't allocate.
+	*/
+	class GameRecordWriter
+	{
+	public:
+		// Starts a record of a game with the settings in header in the capacity bytes at buffer. The
+		// header's numMoves is ignored. Throws std::invalid_argument if the settings can't be recorded
+		// or capacity is less than headerSize.
+		GameRecordWriter(uint8_t* buffer, size_t capacity, const GameRecordHeader& header);
+
+		// Adds a move, returning false if the column isn't on the board or the buffer or the move count
+		// is full.
+		bool addMove(uint8_t column) noexcept;
+
+		// Writes the number of moves into the header and returns the size of the record.
+		size_t finish() noexcept;
+
+		static constexpr size_t headerSize{6};
+		static constexpr uint8_t maxColumns{16};
+		static constexpr uint8_t maxPlayers{15};
+
+		// Returns the size of a record of numMoves moves.
+		static size_t getRecordSize(size_t numMoves) noexcept;
+	private:
+		uint8_t* buffer;
+		size_t capacity;
+		uint8_t numColumns;
+		uint16_t numMoves;
+	};
+
+	/*
+		Reads back a record written by GameRecordWriter, one move at a time, from memory the caller
+		owns. getRecordSize tells where the next record starts when records are stored back to back.
+	*/
+	class GameRecordReader
+	{
+	public:
+		// Reads the header of the record at data. Throws std::invalid_argument if size is too small
+		// for the record or its header is invalid.
+		GameRecordReader(const uint8_t* data, size_t size);
+
+		const GameRecordHeader& getHeader() const noexcept;
+
+		// Sets column to the next move, returning false once every move has been read.
+		bool nextMove(uint8_t& column) noexcept;
+
+		size_t getRecordSize() const noexcept;
+	private:
+		const uint8_t* data;
+		GameRecordHeader header;
+		uint16_t nextIndex;
+	};
+
+	// Records the moves of game in the capacity bytes at buffer, returning the size of the record, or 0
+	// if it doesn't fit. Throws std::invalid_argument if the game can't be recorded.
+	size_t writeGameRecord(const FourAcross& game, uint8_t* buffer, size_t capacity);
+
+	// Replays the record at data. Throws std::invalid_argument if the record is invalid or has a move
+	// that can't be played.
+	FourAcross readGameRecord(const uint8_t* data, size_t size);
+
+	// Writes the columns of numMoves moves to text as one hexadecimal digit each, which must all be
+	// less than 16. Writes numMoves characters and no terminator.
+	void formatMoves(const uint8_t* columns, size_t numMoves, char* text) noexcept;
+
+	// Returns the moves of game as formatMoves writes them. Throws std::invalid_argument if the board
+	// has more than 16 columns.
+	std::string formatMoves(const FourAcross& game);
+
+	// Reads the columns of length digits written by formatMoves into columns, which must have room for
+	// length moves. Throws std::invalid_argument if a character isn't a hexadecimal digit.
+	void parseMoves(const char* text, size_t length, uint8_t* columns);
+}
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	/*
+		Tracks the runs of same-player pieces on a board along the four line directions, so the
+		length of every run through a newly dropped piece is known in constant time regardless
+		of board size. Cells use the same column, row indexing as Board.
+	*/
+	class LineCounters
+	{
+	public:
+		// Constructs empty counters that track nothing.
+		LineCounters() noexcept;
+
+		// Constructs counters for an empty board of the given dimensions.
+		LineCounters(uint8_t numColumns, uint8_t numRows);
+
+		// Records playerNum's piece at column, row, which must be an empty cell, and updates the
+		// runs it joins. playerNum must not be Board::emptySlot.
+		void addPiece(uint8_t column, uint8_t row, uint8_t playerNum) noexcept;
+
+		// Takes back the piece at column, row, which must be the most recently added piece that
+		// hasn't been removed yet, restoring the runs it split.
+		void removePiece(uint8_t column, uint8_t row) noexcept;
+
+		// Returns the length of the longest run through the piece at column, row. Only up to date
+		// for the most recently added piece.
+		uint8_t getLongestRunAt(uint8_t column, uint8_t row) const noexcept;
+
+		// Returns true if the counters track a board.
+		bool isEnabled() const noexcept;
+	private:
+		static constexpr uint8_t numDirections{4};
+
+		size_t getCellIndex(uint8_t column, uint8_t row) const noexcept;
+
+		uint8_t numRows;
+
+		// Cells are stored column by column with a border of empty cells around the board, so
+		// neighbors can be read without bounds checks.
+		std::vector<uint8_t> owners;
+
+		// For each cell and direction, the length of the run the cell belongs to. Only the values
+		// at the ends of a run are kept up to date.
+		std::vector<uint8_t> runs;
+
+		// Distance between neighboring cells in each direction.
+		size_t offsets[numDirections];
+	};
+
+	inline bool LineCounters::isEnabled() const noexcept
+	{
+		return !owners.empty();
+	}
+
+	inline size_t LineCounters::getCellIndex(uint8_t column, uint8_t row) const noexcept
+	{
+		return (column + 1) * (numRows + 2) + row + 1;
+	}
+}
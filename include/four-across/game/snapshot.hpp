@@ -0,0 +1,38 @@
+#pragma once
+
+#include "four-across/game/board.hpp"
+
+#include <cstdint>
+#include <type_traits>
+
+namespace game
+{
+	/*
+		Fixed size copy of a FourAcross game's state, made by FourAcross::snapshot and loaded
+		with FourAcross::restore. It holds no pointers, so it can be copied with memcpy into
+		buffers, shared memory or files and read back as is. Only games with up to maxCells
+		cells fit.
+	*/
+	struct GameSnapshot
+	{
+		static constexpr uint16_t maxCells{Board::maxWideBitboardCells};
+
+		uint32_t numTurns;
+		uint8_t numColumns;
+		uint8_t numRows;
+		uint8_t numPlayers;
+		uint8_t currentPlayer;
+		uint8_t winner;
+		uint8_t winLength;
+		uint8_t winDetection; // FourAcross::WinDetection
+
+		// Owner of each cell, column by column (index = column * numRows + row).
+		uint8_t cells[maxCells];
+
+		// Column of each move taken, in order, so the game can still be undone after a restore.
+		uint8_t moves[maxCells];
+	};
+
+	static_assert(std::is_trivially_copyable<GameSnapshot>::value, "GameSnapshot must be trivially copyable");
+	static_assert(std::is_standard_layout<GameSnapshot>::value, "GameSnapshot must have a fixed layout");
+}
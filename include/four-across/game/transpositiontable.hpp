@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace game
+{
+	/*
+		Fixed size hash table of search results keyed by Zobrist key (see FourAcross::getKey), safe to
+		share between threads without locks. Entries are stored as two atomic words, the key XORed with
+		the data and the data itself, so a probe that reads halves of two different writes sees a key
+		mismatch and misses instead of returning a corrupt entry. Each bucket of entries fills one
+		cache line, so a lookup touches one line of memory.
+	*/
+	class TranspositionTable
+	{
+	public:
+		// What score in an Entry means for the position's true value.
+		enum class Bound : uint8_t
+		{
+			none, exact, lower, upper
+		};
+
+		struct Entry
+		{
+			int16_t score;
+			uint8_t depth;
+			Bound bound;
+			uint8_t bestMove;
+		};
+
+		// Allocates a table using at most numBytes of memory, and at least one bucket. If useHugePages
+		// is true, the table is put in explicit huge pages when the OS has them reserved, which saves
+		// TLB misses on large tables, and otherwise in memory aligned to huge pages with transparent
+		// huge pages requested. usesHugePages tells whether explicit huge pages were used.
+		explicit TranspositionTable(size_t numBytes, bool useHugePages = false);
+
+		TranspositionTable(const TranspositionTable&) = delete;
+
+		~TranspositionTable();
+
+		TranspositionTable& operator=(const TranspositionTable&) = delete;
+
+		// Looks up key, returning true and copying its entry to entry if the table has one.
+		bool probe(uint64_t key, Entry& entry) const noexcept;
+
+		// Stores entry for key, replacing the entry for the same key if there is one, or else the
+		// entry in the bucket from the oldest search with the lowest depth. Entries with
+		// Bound::none aren't stored.
+		void store(uint64_t key, const Entry& entry) noexcept;
+
+		// Marks entries stored from now on as newer than the existing ones, so they're kept in
+		// favor of entries from previous searches.
+		void startNewSearch() noexcept;
+
+		// Removes every entry. Must not be called while other threads use the table.
+		void clear() noexcept;
+
+		size_t getNumEntries() const noexcept;
+		bool usesHugePages() const noexcept;
+
+		static constexpr size_t entriesPerBucket{4};
+		static constexpr size_t bucketSize{64};
+	private:
+		struct Slot
+		{
+			std::atomic<uint64_t> keyXorData;
+			std::atomic<uint64_t> data;
+		};
+
+		struct alignas(bucketSize) Bucket
+		{
+			Slot slots[entriesPerBucket];
+		};
+
+		static uint64_t pack(const Entry& entry, uint8_t generation) noexcept;
+		static Entry unpack(uint64_t data) noexcept;
+		static uint8_t getGeneration(uint64_t data) noexcept;
+
+		Bucket& getBucket(uint64_t key) const noexcept;
+
+		void allocate(size_t numBytes, bool useHugePages);
+
+		Bucket* buckets;
+		size_t numBuckets; // always a power of two
+		void* memory; // start of the allocation holding buckets
+		size_t memorySize;
+		bool isMapped; // memory came from mmap rather than malloc
+		bool hasHugePages;
+		std::atomic<uint8_t> generation;
+	};
+
+	inline size_t TranspositionTable::getNumEntries() const noexcept
+	{
+		return numBuckets * entriesPerBucket;
+	}
+
+	inline bool TranspositionTable::usesHugePages() const noexcept
+	{
+		return hasHugePages;
+	}
+}
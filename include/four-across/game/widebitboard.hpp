@@ -0,0 +1,229 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__AVX2__)
+#include <immintrin.h>
+#endif
+
+namespace game
+{
+	/*
+		Bitboard made of several 64-bit words, for boards with more than 64 cells. Bit i is
+		bit (i % 64) of word i / 64. Bitwise operations use AVX2 (256-bit) or SSE2 (128-bit)
+		lanes when the compiler targets them, and fall back to one word at a time otherwise.
+	*/
+	template<size_t Words>
+	class WideBitboard
+	{
+	public:
+		static constexpr size_t numWords{Words};
+		static constexpr size_t numBits{Words * 64};
+
+		// Copies Words words starting at words.
+		static WideBitboard load(const uint64_t* words) noexcept;
+
+		// Copies the bitboard to Words words starting at words.
+		void store(uint64_t* words) const noexcept;
+
+		void setBit(size_t index) noexcept;
+		void clearBit(size_t index) noexcept;
+		bool testBit(size_t index) const noexcept;
+
+		// Returns true if any bit is set.
+		bool any() const noexcept;
+
+		// Returns the bitboard shifted towards bit 0 by count bits, filling with zeroes.
+		WideBitboard shiftedRight(size_t count) const noexcept;
+
+		WideBitboard operator&(const WideBitboard& other) const noexcept;
+		WideBitboard operator|(const WideBitboard& other) const noexcept;
+		WideBitboard& operator&=(const WideBitboard& other) noexcept;
+		WideBitboard& operator|=(const WideBitboard& other) noexcept;
+	private:
+		alignas(32) uint64_t words[Words];
+	};
+
+	template<size_t Words>
+	constexpr size_t WideBitboard<Words>::numWords;
+
+	template<size_t Words>
+	constexpr size_t WideBitboard<Words>::numBits;
+
+	template<size_t Words>
+	inline WideBitboard<Words> WideBitboard<Words>::load(const uint64_t* words) noexcept
+	{
+		WideBitboard bitboard;
+		std::memcpy(bitboard.words, words, sizeof(bitboard.words));
+		return bitboard;
+	}
+
+	template<size_t Words>
+	inline void WideBitboard<Words>::store(uint64_t* words) const noexcept
+	{
+		std::memcpy(words, this->words, sizeof(this->words));
+	}
+
+	template<size_t Words>
+	inline void WideBitboard<Words>::setBit(size_t index) noexcept
+	{
+		words[index / 64] |= uint64_t{1} << (index % 64);
+	}
+
+	template<size_t Words>
+	inline void WideBitboard<Words>::clearBit(size_t index) noexcept
+	{
+		words[index / 64] &= ~(uint64_t{1} << (index % 64));
+	}
+
+	template<size_t Words>
+	inline bool WideBitboard<Words>::testBit(size_t index) const noexcept
+	{
+		return (words[index / 64] >> (index % 64)) & 1;
+	}
+
+	template<size_t Words>
+	inline bool WideBitboard<Words>::any() const noexcept
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 4 <= Words; i += 4)
+		{
+			const __m256i lane = _mm256_load_si256(reinterpret_cast<const __m256i*>(words + i));
+			if (!_mm256_testz_si256(lane, lane))
+			{
+				return true;
+			}
+		}
+#endif
+		uint64_t bits{0};
+		for (; i < Words; ++i)
+		{
+			bits |= words[i];
+		}
+		return bits != 0;
+	}
+
+	template<size_t Words>
+	WideBitboard<Words> WideBitboard<Words>::shiftedRight(size_t count) const noexcept
+	{
+		// Word i of the result is made from words i + wordShift and i + wordShift + 1 of the source.
+		// Copying the source into a zero padded buffer lets every lane load both without bounds checks.
+		const size_t wordShift = count / 64;
+		const unsigned bitShift = count % 64;
+
+		alignas(32) uint64_t padded[2 * Words + 1]{};
+		std::memcpy(padded, words, sizeof(words));
+
+		WideBitboard shifted;
+		size_t i = 0;
+#if defined(__AVX2__)
+		{
+			const __m128i lowCount = _mm_cvtsi32_si128(static_cast<int>(bitShift));
+			const __m128i highCount = _mm_cvtsi32_si128(static_cast<int>(64 - bitShift)); // 64 shifts everything out
+			for (; i + 4 <= Words; i += 4)
+			{
+				const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded + i + wordShift));
+				const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(padded + i + wordShift + 1));
+				const __m256i lane = _mm256_or_si256(_mm256_srl_epi64(low, lowCount), _mm256_sll_epi64(high, highCount));
+				_mm256_store_si256(reinterpret_cast<__m256i*>(shifted.words + i), lane);
+			}
+		}
+#endif
+#if defined(__SSE2__)
+		{
+			const __m128i lowCount = _mm_cvtsi32_si128(static_cast<int>(bitShift));
+			const __m128i highCount = _mm_cvtsi32_si128(static_cast<int>(64 - bitShift));
+			for (; i + 2 <= Words; i += 2)
+			{
+				const __m128i low = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + i + wordShift));
+				const __m128i high = _mm_loadu_si128(reinterpret_cast<const __m128i*>(padded + i + wordShift + 1));
+				const __m128i lane = _mm_or_si128(_mm_srl_epi64(low, lowCount), _mm_sll_epi64(high, highCount));
+				_mm_store_si128(reinterpret_cast<__m128i*>(shifted.words + i), lane);
+			}
+		}
+#endif
+		for (; i < Words; ++i)
+		{
+			const uint64_t low = padded[i + wordShift];
+			const uint64_t high = padded[i + wordShift + 1];
+			shifted.words[i] = (low >> bitShift) | (bitShift ? high << (64 - bitShift) : 0);
+		}
+		return shifted;
+	}
+
+	template<size_t Words>
+	inline WideBitboard<Words> WideBitboard<Words>::operator&(const WideBitboard& other) const noexcept
+	{
+		WideBitboard result{*this};
+		result &= other;
+		return result;
+	}
+
+	template<size_t Words>
+	inline WideBitboard<Words> WideBitboard<Words>::operator|(const WideBitboard& other) const noexcept
+	{
+		WideBitboard result{*this};
+		result |= other;
+		return result;
+	}
+
+	template<size_t Words>
+	inline WideBitboard<Words>& WideBitboard<Words>::operator&=(const WideBitboard& other) noexcept
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 4 <= Words; i += 4)
+		{
+			const __m256i lhs = _mm256_load_si256(reinterpret_cast<const __m256i*>(words + i));
+			const __m256i rhs = _mm256_load_si256(reinterpret_cast<const __m256i*>(other.words + i));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(words + i), _mm256_and_si256(lhs, rhs));
+		}
+#endif
+#if defined(__SSE2__)
+		for (; i + 2 <= Words; i += 2)
+		{
+			const __m128i lhs = _mm_load_si128(reinterpret_cast<const __m128i*>(words + i));
+			const __m128i rhs = _mm_load_si128(reinterpret_cast<const __m128i*>(other.words + i));
+			_mm_store_si128(reinterpret_cast<__m128i*>(words + i), _mm_and_si128(lhs, rhs));
+		}
+#endif
+		for (; i < Words; ++i)
+		{
+			words[i] &= other.words[i];
+		}
+		return *this;
+	}
+
+	template<size_t Words>
+	inline WideBitboard<Words>& WideBitboard<Words>::operator|=(const WideBitboard& other) noexcept
+	{
+		size_t i = 0;
+#if defined(__AVX2__)
+		for (; i + 4 <= Words; i += 4)
+		{
+			const __m256i lhs = _mm256_load_si256(reinterpret_cast<const __m256i*>(words + i));
+			const __m256i rhs = _mm256_load_si256(reinterpret_cast<const __m256i*>(other.words + i));
+			_mm256_store_si256(reinterpret_cast<__m256i*>(words + i), _mm256_or_si256(lhs, rhs));
+		}
+#endif
+#if defined(__SSE2__)
+		for (; i + 2 <= Words; i += 2)
+		{
+			const __m128i lhs = _mm_load_si128(reinterpret_cast<const __m128i*>(words + i));
+			const __m128i rhs = _mm_load_si128(reinterpret_cast<const __m128i*>(other.words + i));
+			_mm_store_si128(reinterpret_cast<__m128i*>(words + i), _mm_or_si128(lhs, rhs));
+		}
+#endif
+		for (; i < Words; ++i)
+		{
+			words[i] |= other.words[i];
+		}
+		return *this;
+	}
+}
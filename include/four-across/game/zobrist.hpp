@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cstdint>
+
+namespace game
+{
+	/*
+		Zobrist keys identify positions with one 64-bit word: the key of a position is the XOR of
+		a random key for every piece on the board, so dropping or taking back a piece updates it
+		with a single XOR. The random keys are made on the fly by mixing the cell and player with
+		splitmix64 rather than read from tables, so any board size and number of players works.
+	*/
+	namespace zobrist
+	{
+		// splitmix64 finalizer: spreads every input bit over the whole word.
+		constexpr uint64_t mix(uint64_t value) noexcept
+		{
+			value += 0x9e3779b97f4a7c15;
+			value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9;
+			value = (value ^ (value >> 27)) * 0x94d049bb133111eb;
+			return value ^ (value >> 31);
+		}
+
+		// Key of playerNum's piece in cell (column * numRows + row).
+		constexpr uint64_t getPieceKey(uint16_t cell, uint8_t playerNum) noexcept
+		{
+			return mix((uint64_t{cell} << 8) | playerNum);
+		}
+
+		// Key of playerNum being the next to move.
+		constexpr uint64_t getPlayerToMoveKey(uint8_t playerNum) noexcept
+		{
+			return mix((uint64_t{1} << 32) | playerNum);
+		}
+
+		/*
+			A position and its left-right mirror always have the same value. The canonical key of a
+			position is the smaller of its key and its mirror's key, so both share one entry in
+			tables keyed by position. isMirrored tells whether the key is the mirror's, in which case
+			columns stored with the entry are mirrored too.
+		*/
+		struct CanonicalKey
+		{
+			uint64_t key;
+			bool isMirrored;
+		};
+
+		constexpr CanonicalKey getCanonicalKey(uint64_t key, uint64_t mirroredKey) noexcept
+		{
+			return mirroredKey < key ? CanonicalKey{mirroredKey, true} : CanonicalKey{key, false};
+		}
+	}
+}
@@ -79,8 +79,9 @@ namespace game
 				/*
 					Methods for handling changes in game state received from the server.
 				*/
-				// Handles the game starting with the number of players, the first player, and the board dimensions.
-				virtual void onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows) = 0;
+				// Handles the game starting with the number of players, the first player, the board dimensions, and
+				// the number of pieces in a line needed to win.
+				virtual void onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows, uint8_t winLength) = 0;
 
 				// Handles the end of the game. Derived classes can prompt for rematch and call toggleReady or immediately quit.
 				virtual void onGameEnd(uint8_t winner) = 0;
@@ -95,7 +96,7 @@ namespace game
 				virtual void handleTurnRequest() = 0;
 
 			private:
-				void startGame(uint8_t numPlayers, uint8_t first, uint8_t cols, uint8_t rows);
+				void startGame(uint8_t numPlayers, uint8_t first, uint8_t cols, uint8_t rows, uint8_t winLength);
 				void stopGame(uint8_t winner);
 
 				void setPlayerId(uint8_t id);
@@ -25,7 +25,7 @@ namespace game
 				virtual void onConnect(uint8_t playerId) override;
 				virtual void onDisconnect() override;
 				virtual void onQueueUpdate(uint64_t queuePosition) override;
-				virtual void onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows) override;
+				virtual void onGameStart(uint8_t numPlayers, uint8_t firstPlayer, uint8_t cols, uint8_t rows, uint8_t winLength) override;
 				virtual void onGameEnd(uint8_t winner) override;
 				virtual void onGameUpdate(uint8_t player, uint8_t col) override;
 				virtual void onTurnResult(FourAcross::TurnResult result, uint8_t column) override;
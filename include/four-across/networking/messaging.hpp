@@ -40,6 +40,7 @@ namespace game
 				data[1]: number of board columns
 				data[2]: number of board rows
 				data[3]: first player to move
+				data[4]: number of pieces in a line needed to win (0 from older servers means 4)
 			*/
 			gameStart,
 
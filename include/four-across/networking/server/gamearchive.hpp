@@ -0,0 +1,112 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+#include "four-across/game/gamerecord.hpp"
+
+#include <boost/lockfree/queue.hpp>
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace game
+{
+	namespace networking
+	{
+		namespace server
+		{
+			/*
+				Keeps every finished game in append-only segment files in a directory, written by a
+				background thread so the thread running the server never waits on the disk.
+
+				Games are encoded as game records (see GameRecordWriter) by enqueue and passed to the
+				writer thread through a fixed size lock-free queue. The writer appends the queued records
+				to the current segment in batches, calls fdatasync at most every syncInterval, and starts
+				the next segment when a record doesn't fit in segmentBytes. Segments are named
+				games-NNNNNN.far and start with the 8 byte magic FAGAMES1, followed by records back to back.
+				Existing segments are never changed: an archive opened on a directory starts after the
+				segment with the highest number there, even if earlier ones have been removed.
+			*/
+			class GameArchive
+			{
+			public:
+				// Opens the first segment in directory, which must exist, and starts the writer thread.
+				// Throws std::runtime_error if the segment can't be created.
+				GameArchive(const std::string& directory, size_t segmentBytes = defaultSegmentBytes,
+					std::chrono::milliseconds syncInterval = defaultSyncInterval);
+
+				GameArchive(const GameArchive&) = delete;
+
+				// Writes the games still queued, syncs and closes the segment.
+				~GameArchive();
+
+				GameArchive& operator=(const GameArchive&) = delete;
+
+				// Queues the moves of game to be written. Never blocks or allocates: returns false, and
+				// counts the game as dropped, if the queue is full or the game can't be recorded.
+				bool enqueue(const FourAcross& game) noexcept;
+
+				uint64_t getNumWritten() const noexcept;
+				uint64_t getNumDropped() const noexcept;
+
+				static constexpr size_t defaultSegmentBytes{size_t{64} << 20};
+				static constexpr std::chrono::milliseconds defaultSyncInterval{1000};
+				static constexpr size_t queueCapacity{1024};
+
+				// Largest record a queued game can have: one of a board of GameSnapshot::maxCells cells.
+				static constexpr size_t maxRecordBytes{GameRecordWriter::headerSize + (GameSnapshot::maxCells + 1) / 2};
+			private:
+				// A record waiting to be written. Trivially copyable, as the queue requires.
+				struct QueuedRecord
+				{
+					uint16_t size;
+					uint8_t bytes[maxRecordBytes];
+				};
+
+				void runWriter();
+
+				// Returns the path of the segment being written.
+				std::string getSegmentPath() const;
+
+				// Appends the batch to the segment, counting its records as dropped on an error.
+				void writeBatch();
+
+				// Creates the next segment and writes its magic, returning false with errno set on an error.
+				bool openSegment();
+				// Syncs and closes the segment if one is open.
+				void closeSegment();
+
+				std::string directory;
+				size_t segmentBytes;
+				std::chrono::milliseconds syncInterval;
+
+				boost::lockfree::queue<QueuedRecord, boost::lockfree::capacity<queueCapacity>> queue;
+				std::atomic<uint64_t> numWritten;
+				std::atomic<uint64_t> numDropped;
+				std::atomic<bool> isStopping;
+
+				// Owned by the writer thread once it starts.
+				std::vector<uint8_t> batch;
+				size_t batchRecords;
+				int segmentFile;
+				uint32_t segmentIndex;
+				size_t segmentSize;
+				bool hasUnsyncedWrites;
+				std::thread writer;
+			};
+
+			inline uint64_t GameArchive::getNumWritten() const noexcept
+			{
+				return numWritten.load(std::memory_order_relaxed);
+			}
+
+			inline uint64_t GameArchive::getNumDropped() const noexcept
+			{
+				return numDropped.load(std::memory_order_relaxed);
+			}
+		}
+	}
+}
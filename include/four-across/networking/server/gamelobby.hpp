@@ -2,6 +2,7 @@
 
 #include "four-across/game/game.hpp"
 #include "four-across/networking/server/connection.hpp"
+#include "four-across/networking/server/gamearchive.hpp"
 
 #include "four-across/networking/messaging.hpp"
 
@@ -33,7 +34,10 @@ namespace game
 
 				ADD_SIGNAL(LobbyAvailable, lobbyAvailable, void, GameLobby*)
 			public:
-				GameLobby(uint8_t maxPlayers = FourAcross::minNumPlayers);
+				// Constructs a lobby whose games need winLength pieces in a line to win. Finished games are
+				// queued to archive, if there is one, which must outlive the lobby.
+				GameLobby(uint8_t maxPlayers = FourAcross::minNumPlayers, uint8_t winLength = FourAcross::defaultWinLength,
+					GameArchive* archive = nullptr);
 
 				GameLobby(const GameLobby&) = delete;
 
@@ -82,7 +86,9 @@ namespace game
 				bool isPlayingGame;
 
 				std::unique_ptr<FourAcross> game;
+				GameArchive* archive;
 				uint8_t maxPlayers;
+				uint8_t winLength;
 				uint8_t numReady;
 				uint8_t numPlayers;
 				std::vector<std::shared_ptr<Connection>> players;
@@ -15,6 +15,7 @@ namespace game
 	{
 		namespace server
 		{
+			class GameArchive; // Keeps finished games on disk
 			class GameLobby; // Runs a FourAcross game
 			class Connection; // Maintains connection from client
 
@@ -25,10 +26,12 @@ namespace game
 			class Server
 			{
 			public:
+				// Finished games are queued to archive, if there is one, which must outlive the server.
 				Server(
 					boost::asio::io_service& ioService,
 					std::string address,
-					uint16_t port);
+					uint16_t port,
+					GameArchive* archive = nullptr);
 				Server(const Server&) = delete;
 				~Server();
 
@@ -51,6 +54,7 @@ namespace game
 				boost::asio::io_service& ioService;
 				boost::asio::ip::tcp::acceptor acceptor;
 				boost::asio::steady_timer queueUpdateTimer;
+				GameArchive* archive;
 
 				size_t lastQueueSize;
 				std::list<std::shared_ptr<Connection>> playerQueue;
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "four-across/game/concurrentkeyset.hpp"
+#include "four-across/game/game.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	namespace perft
+	{
+		struct PerftResult
+		{
+			// Entry i is the number of move sequences of i + 1 turns played from the start position.
+			// Games that are won or full end their sequences.
+			std::vector<uint64_t> numSequences;
+			// Entry i is the number of those sequences that reach a position no other sequence reached
+			// first, which is the number of distinct positions i + 1 turns in.
+			std::vector<uint64_t> numPositions;
+			// False if the key set filled up, leaving numPositions short.
+			bool isComplete;
+			double seconds;
+			double sequencesPerSecond;
+		};
+
+		/*
+			Plays every sequence of up to depth turns from game, counting the sequences and the distinct
+			positions they reach at each depth. The first few turns are played on the calling thread
+			to split the tree into at least a few subtrees per thread, then numThreads threads take
+			subtrees until none are left. Positions are told apart by Zobrist key, in positions, which
+			should start empty.
+		*/
+		PerftResult countPositions(const FourAcross& game, uint8_t depth, unsigned numThreads, ConcurrentKeySet& positions);
+	}
+}
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+#include "four-across/selfplay/policy.hpp"
+#include "four-across/solver/montecarlotreesearch.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <string>
+
+namespace game
+{
+	namespace selfplay
+	{
+		// How an Engine picks moves.
+		struct EngineConfig
+		{
+			enum class Kind : uint8_t
+			{
+				policy, monteCarlo, alphaBeta
+			};
+
+			Kind kind;
+			Policy policy; // for Kind::policy
+			uint64_t iterations; // playouts per move, for Kind::monteCarlo
+			uint8_t depth; // plies searched per move, for Kind::alphaBeta
+		};
+
+		// Returns the engine named name: a policy name (see parsePolicy), "mcts:ITERATIONS" or
+		// "alphabeta:DEPTH". Throws std::invalid_argument for anything else.
+		EngineConfig parseEngine(const std::string& name);
+
+		// Returns the name parseEngine reads as config.
+		std::string getEngineName(const EngineConfig& config);
+
+		/*
+			Plays moves chosen as its config says, keeping the searches it uses between moves so their
+			memory is reused. Searches use one thread; play games on several threads with one Engine each.
+		*/
+		class Engine
+		{
+		public:
+			Engine(const EngineConfig& config, uint32_t seed);
+
+			Engine(const Engine&) = delete;
+
+			Engine& operator=(const Engine&) = delete;
+
+			// Returns the column to play in game, which must not be over. Alpha-beta engines only play
+			// two player games and throw std::invalid_argument otherwise.
+			uint8_t chooseMove(FourAcross& game);
+
+			const EngineConfig& getConfig() const noexcept;
+
+			static constexpr size_t searchBytes{size_t{16} << 20};
+		private:
+			EngineConfig config;
+			std::default_random_engine engine;
+			std::unique_ptr<solver::MonteCarloTreeSearch> monteCarlo;
+			std::unique_ptr<solver::Solver> alphaBeta;
+		};
+
+		inline const EngineConfig& Engine::getConfig() const noexcept
+		{
+			return config;
+		}
+	}
+}
@@ -0,0 +1,36 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstdint>
+#include <random>
+#include <string>
+
+namespace game
+{
+	namespace selfplay
+	{
+		// Ways of picking moves without search, for simulating games quickly.
+		enum class Policy : uint8_t
+		{
+			// Any column that isn't full, each as likely as the others.
+			random,
+			// Any column that isn't full, with columns further from the edges more likely: a column's
+			// weight is its distance to the nearest edge plus one.
+			centerBiased,
+			// A column that wins at once if there is one, otherwise a center biased choice among the
+			// columns after which the next player can't win at once (blocking them), if there are any.
+			greedy
+		};
+
+		// Returns the policy named name: "random", "center" or "greedy". Throws std::invalid_argument
+		// for any other name.
+		Policy parsePolicy(const std::string& name);
+
+		const char* getPolicyName(Policy policy) noexcept;
+
+		// Returns the column policy picks for the player to move in game, which must not be over.
+		// The greedy policy tries moves on game and takes them back before returning. Doesn't allocate.
+		uint8_t chooseMove(Policy policy, FourAcross& game, std::default_random_engine& engine) noexcept;
+	}
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include "four-across/selfplay/policy.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	namespace selfplay
+	{
+		struct SimulationSettings
+		{
+			uint8_t numPlayers;
+			uint8_t numColumns;
+			uint8_t numRows;
+			uint8_t winLength;
+			// Policy of each player, in turn order from player 1, or one policy for every player.
+			std::vector<Policy> policies;
+			uint64_t numGames;
+			unsigned numThreads;
+			// Game i uses a random engine seeded with seed + i, so results don't depend on numThreads.
+			uint32_t seed;
+		};
+
+		struct SimulationResult
+		{
+			uint64_t numGames;
+			// Entry i is the number of games player i + 1 won. Player 1 moves first.
+			std::vector<uint64_t> wins;
+			uint64_t draws;
+			// Entry i is the number of games that ended after i turns.
+			std::vector<uint64_t> gameLengths;
+			double seconds;
+			double gamesPerSecond;
+		};
+
+		/*
+			Plays numGames complete games with the settings' policies, with numThreads threads taking
+			batches of games until none are left. Moves are played with FourAcross::takeTurn, so the
+			simulation exercises the same code as real games. Throws std::invalid_argument if the
+			settings aren't valid game settings or the number of policies is neither 1 nor numPlayers.
+		*/
+		SimulationResult simulate(const SimulationSettings& settings);
+	}
+}
@@ -0,0 +1,87 @@
+#pragma once
+
+#include "four-across/selfplay/engine.hpp"
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+namespace game
+{
+	namespace selfplay
+	{
+		// Hypotheses of a sequential probability ratio test of the Elo difference between two engines:
+		// H0 that it's elo0, H1 that it's elo1, with false positive rate alpha and false negative rate beta.
+		struct SprtSettings
+		{
+			double elo0;
+			double elo1;
+			double alpha;
+			double beta;
+		};
+
+		struct TournamentSettings
+		{
+			uint8_t numColumns;
+			uint8_t numRows;
+			uint8_t winLength;
+			std::array<EngineConfig, 2> engines;
+			// Moves played before the engines take over, used in turn by each pair of games. The games
+			// start from the empty board if there are none.
+			std::vector<std::vector<uint8_t>> openings;
+			// Pairs of games to play: each opening is played twice, with the engines swapping colors.
+			uint64_t numPairs;
+			unsigned numThreads;
+			// Stop once the test accepts a hypothesis, if set.
+			bool useSprt;
+			SprtSettings sprt;
+			uint32_t seed;
+			// Where to write a record of each game, or nullptr.
+			std::ostream* records;
+		};
+
+		struct TournamentResult
+		{
+			enum class Decision : uint8_t
+			{
+				none, acceptedH0, acceptedH1
+			};
+
+			uint64_t numGames;
+			// Results of engines[0].
+			uint64_t wins;
+			uint64_t losses;
+			uint64_t draws;
+			// Average result of engines[0], counting a draw as half a win, and the Elo difference it
+			// makes for engines[0].
+			double score;
+			double eloDifference;
+			// Log likelihood ratio of H1 against H0, and the test's decision.
+			double logLikelihoodRatio;
+			Decision decision;
+			double seconds;
+			double gamesPerSecond;
+		};
+
+		/*
+			Plays pairs of two player games between two engines on a work stealing pool of threads
+			(see runWorkStealing), one pair per task, with each thread keeping its own engines. After
+			every pair the sequential probability ratio test is updated, and once it accepts a hypothesis
+			the decision is final: pairs not yet started are skipped, and pairs still being played are
+			left out of the results and records. Records are written as each pair finishes, like PGN:
+			tag pairs, then the numbered moves (columns from 0) and the result.
+
+			The test treats games as independent with a win, draw or loss each, using the normal
+			approximation of the log likelihood ratio. Throws std::invalid_argument if the board
+			settings are invalid or an opening can't be played or ends the game.
+		*/
+		TournamentResult playTournament(const TournamentSettings& settings);
+
+		// Log likelihood ratio of an Elo difference of elo1 against one of elo0, given the results.
+		double getLogLikelihoodRatio(uint64_t wins, uint64_t draws, uint64_t losses, double elo0, double elo1) noexcept;
+
+		// Returns the Elo difference that makes score the expected average result.
+		double getEloDifference(double score) noexcept;
+	}
+}
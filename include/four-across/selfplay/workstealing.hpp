@@ -0,0 +1,22 @@
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace game
+{
+	namespace selfplay
+	{
+		// Called with the index of the thread running a task and the task's index.
+		using task_runner_t = std::function<void(unsigned thread, size_t task)>;
+
+		/*
+			Runs tasks 0 to numTasks - 1 on numThreads threads, the calling thread being thread 0, and
+			returns once all have run. Each thread starts with its own queue of an even share of the
+			tasks, dealt out in turn, and runs them from the back. A thread whose queue is empty takes
+			tasks from the front of another thread's queue, so threads that get quick tasks help out the
+			ones that get slow tasks. Exceptions from runTask end the program.
+		*/
+		void runWorkStealing(size_t numTasks, unsigned numThreads, const task_runner_t& runTask);
+	}
+}
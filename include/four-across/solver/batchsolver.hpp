@@ -0,0 +1,100 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+#include "four-across/game/snapshot.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		/*
+			Scores many independent positions at once, for throughput rather than the speed of one search.
+			Keeps a pool of threads, each with its own single threaded Solver and game that are reused
+			from one position to the next, and hands out positions one at a time so uneven searches
+			balance out. Results are passed back on the calling thread in the order of the positions.
+		*/
+		class BatchSolver
+		{
+		public:
+			// Called with the index of a position and its result.
+			using result_handler_t = std::function<void(size_t index, const SearchResult& result)>;
+
+			explicit BatchSolver(
+				unsigned numThreads = std::thread::hardware_concurrency(),
+				size_t tableBytesPerThread = defaultTableBytesPerThread);
+
+			BatchSolver(const BatchSolver&) = delete;
+
+			~BatchSolver();
+
+			BatchSolver& operator=(const BatchSolver&) = delete;
+
+			// Scores numPositions snapshots, calling onResult for each as soon as it and every position
+			// before it are done. Returns once all results are passed on. Throws std::invalid_argument
+			// if a snapshot isn't of a two player game.
+			void solve(const GameSnapshot* positions, size_t numPositions, const SearchLimits& limits,
+				const result_handler_t& onResult);
+
+			// Same as above for positions given as the columns played from the start of a two player game
+			// with the given settings, player 1 first. Moves that can't be played are skipped.
+			void solve(const std::vector<uint8_t>* moveLists, size_t numPositions,
+				uint8_t numColumns, uint8_t numRows, uint8_t winLength, const SearchLimits& limits,
+				const result_handler_t& onResult);
+
+			unsigned getNumThreads() const noexcept;
+
+			static constexpr size_t defaultTableBytesPerThread{size_t{16} << 20};
+		private:
+			// Search state owned by one pool thread.
+			struct Worker
+			{
+				explicit Worker(size_t tableBytes);
+
+				Solver solver;
+				FourAcross game;
+			};
+
+			// Loads the position at index into worker.game.
+			using position_loader_t = std::function<void(Worker& worker, size_t index)>;
+
+			void run(size_t numPositions, const SearchLimits& limits, const position_loader_t& loadPosition,
+				const result_handler_t& onResult);
+
+			void runWorker(Worker& worker);
+
+			std::vector<std::unique_ptr<Worker>> workers;
+			std::vector<std::thread> threads;
+
+			// The batch being solved, guarded by mutex.
+			std::mutex mutex;
+			std::condition_variable batchStarted;
+			std::condition_variable resultReady;
+			uint64_t batchNumber;
+			size_t numPositions;
+			size_t nextPosition;
+			size_t numBusyWorkers;
+			const position_loader_t* loadPosition;
+			SearchLimits limits;
+			std::vector<SearchResult> results;
+			std::vector<bool> isResultReady;
+			std::exception_ptr error;
+			bool isShuttingDown;
+		};
+
+		inline unsigned BatchSolver::getNumThreads() const noexcept
+		{
+			return static_cast<unsigned>(threads.size());
+		}
+	}
+}
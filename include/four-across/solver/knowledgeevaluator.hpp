@@ -0,0 +1,89 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		struct Knowledge
+		{
+			// What the rules prove for the player to move.
+			enum class Outcome : uint8_t
+			{
+				unknown, win, loss, draw, atLeastDraw, atMostDraw
+			};
+
+			Outcome outcome;
+			// The winning move for a win, a move keeping at least a draw for draw and atLeastDraw, the
+			// only move that doesn't lose at once if there is one, and otherwise Solver::noMove.
+			uint8_t bestMove;
+			// Bit c is set if column c can be played without losing at once.
+			uint64_t allowedMoves;
+			// Empty cells that would complete a line, for the player to move and for the other player,
+			// one bit per cell (column * numRows + row).
+			uint64_t threats[2];
+		};
+
+		/*
+			Decides two player FourAcross positions from rules rather than search, after Allis' rules
+			for Connect Four, using bitmasks of the board's cells.
+
+			Threats are empty cells that would complete a line for a player. A playable threat wins
+			at once, two playable threats of the other player lose, and a move under the other
+			player's threat loses.
+
+			Zugzwang control decides the rest. The player who doesn't have the move can follow up every
+			move of the other player if the empty cells split into pairs that the other player always
+			enters first: two cells stacked in a column (claimeven when the upper cell is in an even
+			row counting from 1, vertical otherwise), and the playable cells of two columns with an odd
+			number of empty cells (baseinverse). The follower gets the upper cell of each stacked
+			pair and one cell of each baseinverse, so every line of the other player through one of
+			those, or through both cells of a baseinverse, is refuted. If some way of pairing the
+			columns refutes every line the other player could still complete, the follower is sure of
+			at least a draw. The pairs of different rules never share a cell, so their refutations
+			combine.
+		*/
+		class KnowledgeEvaluator
+		{
+		public:
+			// Prepares the lines of a board with the given settings. Throws std::invalid_argument if the
+			// board has more than 64 cells or the win length is invalid.
+			KnowledgeEvaluator(uint8_t numColumns, uint8_t numRows, uint8_t winLength = FourAcross::defaultWinLength);
+
+			// Applies the rules to the position of game. Throws std::invalid_argument if the game
+			// doesn't have two players or has other settings than the evaluator.
+			Knowledge evaluate(const FourAcross& game) const;
+		private:
+			// Returns true if the player with follower's pieces, who doesn't have the move, can keep the
+			// other player from completing any line by following up their moves.
+			bool canFollowUp(uint64_t follower, uint64_t occupied) const noexcept;
+
+			// Tries every way of pairing the playable cells of oddColumns as baseinverses, returning true
+			// if one of them has both cells of some pair in every one of openLines.
+			bool pairColumns(const uint8_t* oddColumns, size_t numOddColumns, uint64_t* pairs, size_t numPairs,
+				const uint64_t* openLines, size_t numOpenLines, uint64_t occupied) const noexcept;
+
+			// Returns the cells completing a line for player, who owns pieces, given the occupied cells.
+			uint64_t getThreats(uint64_t pieces, uint64_t occupied) const noexcept;
+
+			// Returns the cell a piece dropped in column would land in, or 0 if the column is full.
+			uint64_t getPlayableCell(uint8_t column, uint64_t occupied) const noexcept;
+
+			uint8_t getHeight(uint8_t column, uint64_t occupied) const noexcept;
+
+			uint8_t numColumns;
+			uint8_t numRows;
+			uint8_t winLength;
+			std::vector<uint64_t> lines; // every line of winLength cells on the board
+			std::vector<uint64_t> columnMasks;
+
+			// A board of 64 cells has at most 16 columns and 4 lines through each cell.
+			static constexpr size_t maxColumns{16};
+			static constexpr size_t maxLines{4 * 64};
+		};
+	}
+}
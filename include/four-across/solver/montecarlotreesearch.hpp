@@ -0,0 +1,147 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		// Bounds on how long a search runs. Zero means no limit, but one of them has to be set.
+		struct MonteCarloLimits
+		{
+			// Time the search may take, in seconds.
+			double seconds;
+			// Number of playouts after which the search stops.
+			uint64_t maxIterations;
+		};
+
+		struct MonteCarloResult
+		{
+			// Most visited column, or Solver::noMove if the game is over.
+			uint8_t bestMove;
+			// Average result of bestMove for the player to move, from 0 for a loss to 1 for a win, with
+			// a draw worth 1 / number of players.
+			double value;
+			// Number of times bestMove was tried.
+			uint32_t bestMoveVisits;
+			uint64_t numIterations;
+			// Nodes taken from the arena.
+			uint64_t numNodes;
+			// True if the arena ran out, after which the tree stopped growing.
+			bool isArenaFull;
+			double seconds;
+			double iterationsPerSecond;
+		};
+
+		/*
+			Picks moves in FourAcross games of any board size and number of players with Monte Carlo
+			tree search. Each iteration goes down the tree choosing moves by UCT, adds the children of
+			the position it stops at, plays random moves to the end of the game from there, and credits
+			the result to the player who made each move on the way down. A win is worth 1, a draw
+			1 / number of players and a loss 0, so every player plays for their own win.
+
+			Threads grow one tree without locks: a thread counts its visit of a node on the way down,
+			before the result is known, which counts as a loss until the result is added and steers
+			other threads to other moves (virtual loss). Nodes come from an arena of fixed size that
+			every search starts over, so playing a game doesn't allocate after the first move.
+		*/
+		class MonteCarloTreeSearch
+		{
+		public:
+			explicit MonteCarloTreeSearch(size_t arenaBytes = defaultArenaBytes, unsigned numThreads = 1,
+				uint32_t seed = std::mt19937::default_seed);
+
+			MonteCarloTreeSearch(const MonteCarloTreeSearch&) = delete;
+
+			MonteCarloTreeSearch& operator=(const MonteCarloTreeSearch&) = delete;
+
+			// Searches the position of game on copies of it until a limit is reached. Throws
+			// std::invalid_argument if neither limit is set.
+			MonteCarloResult search(const FourAcross& game, const MonteCarloLimits& limits);
+
+			// Number of nodes the arena holds.
+			size_t getArenaSize() const noexcept;
+
+			unsigned getNumThreads() const noexcept;
+
+			// Weight of exploring moves tried less often against playing the best ones, sqrt(2) in
+			// the UCT paper.
+			static constexpr double explorationWeight{1.41421356};
+			static constexpr size_t defaultArenaBytes{size_t{64} << 20};
+		private:
+			struct Node
+			{
+				// Sum of the results of the player who made move, in units of 1 / number of players.
+				std::atomic<uint64_t> reward;
+				std::atomic<uint32_t> visits;
+				std::atomic<uint8_t> state;
+				uint32_t firstChild; // set before state becomes expanded, children are adjacent
+				uint8_t numChildren;
+				uint8_t move;
+			};
+
+			enum NodeState : uint8_t
+			{
+				unexpanded, expanding, expanded
+			};
+
+			// Search state owned by one thread, kept between searches so its memory is reused.
+			struct Worker
+			{
+				FourAcross game;
+				std::mt19937 engine;
+				std::vector<uint32_t> path;
+				std::vector<uint8_t> movers; // player who made the move into each node of path
+				uint64_t numIterations;
+			};
+
+			void runWorker(Worker& worker);
+
+			// Runs one iteration from the root.
+			void runIteration(Worker& worker);
+
+			// Adds the children of node, the position of game, returning false if the arena is full.
+			bool expand(uint32_t node, const FourAcross& game) noexcept;
+
+			// Returns the child of node with the highest UCT value.
+			uint32_t select(uint32_t node) const noexcept;
+
+			// Plays random moves to the end of the game, returning the number played.
+			uint32_t playOut(Worker& worker) noexcept;
+
+			bool shouldStop() noexcept;
+
+			std::unique_ptr<Node[]> nodes;
+			size_t arenaSize;
+			std::vector<Worker> workers; // the calling thread's first, then one per helper thread
+			std::vector<uint8_t> columnOrder; // center columns first
+			uint8_t numPlayers;
+
+			std::atomic<uint64_t> nextFree;
+			std::atomic<bool> isArenaFull;
+			std::atomic<uint64_t> numIterations;
+			std::atomic<bool> isStopped;
+			uint64_t maxIterations;
+			std::chrono::steady_clock::time_point deadline;
+			bool hasDeadline;
+		};
+
+		inline size_t MonteCarloTreeSearch::getArenaSize() const noexcept
+		{
+			return arenaSize;
+		}
+
+		inline unsigned MonteCarloTreeSearch::getNumThreads() const noexcept
+		{
+			return static_cast<unsigned>(workers.size());
+		}
+	}
+}
@@ -0,0 +1,94 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		/*
+			Read-only table of precomputed Solver results for the early positions of one board size and
+			win length, stored in a file as records sorted by canonical Zobrist key (see
+			FourAcross::getCanonicalKey), so a position and its mirror image share a record. The file is
+			memory mapped where the OS supports it, so opening a book costs nothing up front and
+			processes using the same book share its pages. Lookups are a binary search over the mapped
+			records.
+
+			Books are written with OpeningBook::write, usually by the buildbook tool, and use the byte
+			order of the machine that wrote them.
+		*/
+		class OpeningBook
+		{
+		public:
+			struct Entry
+			{
+				// Same meaning as SearchResult::score.
+				int16_t score;
+				uint8_t bestMove;
+				// Deepest search finished, or solvedDepth if score is the game-theoretic value.
+				uint8_t depth;
+			};
+
+			// A position to write, by canonical key, with its best move for the canonical orientation.
+			struct Position
+			{
+				uint64_t key;
+				Entry entry;
+			};
+
+			// Maps the book at path. Throws std::runtime_error if the file can't be read or isn't a book.
+			explicit OpeningBook(const std::string& path);
+
+			OpeningBook(const OpeningBook&) = delete;
+
+			~OpeningBook();
+
+			OpeningBook& operator=(const OpeningBook&) = delete;
+
+			// Looks up the position of game, returning true and copying its entry to entry if the book
+			// has it, with the best move mirrored back if the game is the mirror of the stored position.
+			// Games with other settings than the book's are never found.
+			bool probe(const FourAcross& game, Entry& entry) const noexcept;
+
+			// Looks up a position by canonical key, with the best move as stored.
+			bool probe(uint64_t key, Entry& entry) const noexcept;
+
+			uint8_t getNumColumns() const noexcept;
+			uint8_t getNumRows() const noexcept;
+			uint8_t getWinLength() const noexcept;
+			// Number of turns taken in the latest positions in the book.
+			uint8_t getMaxPly() const noexcept;
+			size_t getNumEntries() const noexcept;
+
+			// Writes a book of positions to path, sorting them by key first. Throws std::runtime_error
+			// if the file can't be written.
+			static void write(const std::string& path, uint8_t numColumns, uint8_t numRows, uint8_t winLength,
+				uint8_t maxPly, std::vector<Position> positions);
+
+			static constexpr uint8_t solvedDepth{255};
+		private:
+			struct Header;
+			struct Record;
+
+			const Header* header;
+			const Record* records;
+			size_t numRecords;
+
+			// The file's contents: mapped if isMapped, otherwise read into buffer.
+			void* memory;
+			size_t memorySize;
+			bool isMapped;
+			std::vector<char> buffer;
+		};
+
+		inline size_t OpeningBook::getNumEntries() const noexcept
+		{
+			return numRecords;
+		}
+	}
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		struct ProofResult
+		{
+			// Result for the player to move, or unknown if the search ran out of nodes or memory.
+			enum class Outcome : uint8_t
+			{
+				win, loss, draw, unknown
+			};
+
+			Outcome outcome;
+			// Column that wins, if outcome is win, otherwise Solver::noMove.
+			uint8_t bestMove;
+			// Number of positions in the proof: the winning moves and every reply to them down to the
+			// end of the game, or every move of a search whose goal was disproven.
+			uint64_t proofSize;
+			// Positions added to the tree, counting ones collected and added again.
+			uint64_t numNodes;
+			// Number of times solved subtrees were freed to make room.
+			uint64_t numCollections;
+			double seconds;
+			double nodesPerSecond;
+		};
+
+		/*
+			Solves two player FourAcross positions with proof-number search, which suits boards too wide
+			for alpha-beta: rather than searching every move to a depth it grows a tree of positions
+			best first, always expanding the position that would do the most towards proving or
+			disproving that one player wins. Each position keeps the number of unsolved leaves that
+			would have to be proven (its proof number) or disproven (its disproof number) to settle it.
+
+			Nodes come from an arena of fixed size. When it runs out, the subtrees under solved
+			positions are freed, keeping only the solved positions' results. A search proves or
+			disproves that the player to move wins, and after a disproof that the other player wins,
+			telling a loss from a draw.
+		*/
+		class ProofNumberSearch
+		{
+		public:
+			explicit ProofNumberSearch(size_t arenaBytes = defaultArenaBytes);
+
+			ProofNumberSearch(const ProofNumberSearch&) = delete;
+
+			ProofNumberSearch& operator=(const ProofNumberSearch&) = delete;
+
+			// Solves the position of game, adding at most maxNodes positions to the tree unless
+			// maxNodes is 0. Throws std::invalid_argument if the game doesn't have two players.
+			ProofResult solve(const FourAcross& game, uint64_t maxNodes = 0);
+
+			// Number of nodes the arena holds.
+			size_t getArenaSize() const noexcept;
+
+			static constexpr size_t defaultArenaBytes{size_t{64} << 20};
+		private:
+			struct Node
+			{
+				uint32_t proof;
+				uint32_t disproof;
+				uint32_t parent;
+				uint32_t firstChild;
+				uint32_t nextSibling; // or the next free node, for nodes in the free list
+				uint8_t move;
+				// Set once the node is solved: the size of its proof, or of its disproof.
+				uint64_t proofSize;
+			};
+
+			// Result of proving whether attacker wins from the position of game.
+			enum class Proof : uint8_t
+			{
+				proven, disproven, unknown
+			};
+
+			Proof prove(uint8_t attacker, uint64_t maxNodes);
+
+			// Adds the children of node, the position of game.
+			void expand(uint32_t node, uint8_t attacker);
+
+			// Sets the proof and disproof numbers of an expanded node from its children.
+			void update(uint32_t node, bool isOrNode) noexcept;
+
+			// Sets the proof and disproof numbers of a new node for the position of game.
+			void evaluate(Node& node, uint8_t attacker) const noexcept;
+
+			uint32_t allocate() noexcept;
+			void freeChildren(uint32_t node) noexcept;
+
+			// Frees the children of every solved node in the tree.
+			void collectGarbage() noexcept;
+
+			bool isSolved(const Node& node) const noexcept;
+
+			FourAcross game;
+			std::vector<Node> nodes;
+			std::vector<uint8_t> columnOrder; // center columns first
+			std::vector<uint32_t> pending; // scratch stack for walking the tree
+			uint32_t root;
+			uint32_t firstFree;
+			size_t numFree;
+			uint64_t numNodes;
+			uint64_t numCollections;
+		};
+
+		inline size_t ProofNumberSearch::getArenaSize() const noexcept
+		{
+			return nodes.size();
+		}
+	}
+}
@@ -0,0 +1,143 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+#include "four-across/game/transpositiontable.hpp"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		class OpeningBook;
+		class Tablebase;
+
+		// Bounds on how much work a search may do. Zero means no limit.
+		struct SearchLimits
+		{
+			// Deepest number of plies searched, up to Solver::maxDepth.
+			uint8_t maxDepth;
+			// Number of positions visited after which the search stops with its last finished depth.
+			uint64_t maxNodes;
+		};
+
+		struct SearchResult
+		{
+			// Value of the position for the player to move: 0 for a draw or an unknown result,
+			// Solver::winScore - n for a win n plies from now and -(Solver::winScore - n) for a loss.
+			int16_t score;
+			// Column to play, or Solver::noMove if the game is over.
+			uint8_t bestMove;
+			// Deepest search finished.
+			uint8_t depth;
+			// True if score is the game-theoretic value rather than an estimate from a limited depth.
+			bool isSolved;
+			uint64_t numNodes;
+			double seconds;
+			double nodesPerSecond;
+		};
+
+		/*
+			Finds the best move and value of two player FourAcross positions with negamax alpha-beta search,
+			deepened one ply at a time. Moves are tried best move from the transposition table first, then
+			center columns before edge ones. Positions share transposition table entries with their mirror
+			images. Keeps its transposition table between searches of games with the same board size and
+			win length.
+
+			With more than one thread the search is Lazy SMP: every thread searches the same position on
+			its own copy of the game, sharing only the lock-free transposition table, and half of the
+			helper threads run one ply ahead of the calling thread. Results the helpers store let the
+			calling thread skip most of its subtrees, and it reports the result when it finishes.
+		*/
+		class Solver
+		{
+		public:
+			explicit Solver(size_t tableBytes = defaultTableBytes, unsigned numThreads = 1);
+
+			Solver(const Solver&) = delete;
+
+			Solver& operator=(const Solver&) = delete;
+
+			// Searches the position of game on copies of it. Throws std::invalid_argument if the game
+			// doesn't have two players.
+			SearchResult solve(const FourAcross& game, const SearchLimits& limits = SearchLimits{});
+
+			// Forgets every position searched before.
+			void clear() noexcept;
+
+			// Answers searches of positions in book from it when its entry is solved or at least as deep
+			// as the search would be. The book must outlive the solver, or be unset with nullptr.
+			void setOpeningBook(const OpeningBook* book) noexcept;
+
+			// Answers searches of positions in tablebase from it, choosing the move by looking up the
+			// positions after each move. The tablebase must outlive the solver, or be unset with nullptr.
+			void setTablebase(const Tablebase* tablebase) noexcept;
+
+			unsigned getNumThreads() const noexcept;
+
+			static bool isWinScore(int score) noexcept;
+			static bool isLossScore(int score) noexcept;
+
+			static constexpr int16_t winScore{30000};
+			static constexpr uint8_t maxDepth{254};
+			static constexpr uint8_t noMove{255};
+			static constexpr size_t defaultTableBytes{size_t{64} << 20};
+		private:
+			// Search state owned by one thread, kept between searches so its memory is reused.
+			struct Worker
+			{
+				FourAcross game;
+				uint64_t numNodes;
+				uint64_t unsharedNodes; // nodes not yet added to Solver::sharedNodes
+				uint8_t rootBestMove;
+				bool reachedHorizon; // a position in the current subtree was cut off by the depth limit
+				bool isAborted;
+			};
+
+			// Deepens the search of a helper thread until the calling thread finishes.
+			void runHelper(Worker& worker, uint8_t firstDepth, uint8_t depthLimit);
+
+			int negamax(Worker& worker, uint8_t depth, uint8_t ply, int alpha, int beta);
+
+			// Counts a visited node, returning false if the search has to stop.
+			bool countNode(Worker& worker) noexcept;
+
+			// Converts win and loss scores between distances from the root and distances from the position
+			// stored, so table entries are valid wherever the position appears in the tree.
+			static int16_t toTableScore(int score, uint8_t ply) noexcept;
+			static int fromTableScore(int16_t score, uint8_t ply) noexcept;
+
+			TranspositionTable table;
+			std::vector<uint8_t> columnOrder; // center columns first
+			std::vector<Worker> workers; // the calling thread's first, then one per helper thread
+			const OpeningBook* book;
+			const Tablebase* tablebase;
+
+			// Settings of the last game searched: keys of other games mean different positions.
+			uint8_t tableColumns;
+			uint8_t tableRows;
+			uint8_t tableWinLength;
+			uint64_t maxNodes;
+			std::atomic<uint64_t> sharedNodes;
+			std::atomic<bool> isStopped;
+		};
+
+		inline unsigned Solver::getNumThreads() const noexcept
+		{
+			return static_cast<unsigned>(workers.size());
+		}
+
+		inline bool Solver::isWinScore(int score) noexcept
+		{
+			return score > winScore - maxDepth - 1;
+		}
+
+		inline bool Solver::isLossScore(int score) noexcept
+		{
+			return score < -(winScore - maxDepth - 1);
+		}
+	}
+}
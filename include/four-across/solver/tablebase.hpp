@@ -0,0 +1,109 @@
+#pragma once
+
+#include "four-across/game/game.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace game
+{
+	namespace solver
+	{
+		/*
+			Perfect play results for every reachable position of a two player game on a small board,
+			computed by retrograde analysis: positions are found one ply at a time from the empty board,
+			then valued from the full boards back to the empty one, each from the values of the
+			positions after it.
+
+			Positions are numbered by the contents of their columns, each column being its height and
+			which pieces belong to the player to move, so a position's number is computed straight from
+			its board. Only reachable positions are stored: a bitmap over all numbers marks them, and a
+			count of the marked bits before every block of the bitmap finds a position's value in
+			constant time.
+		*/
+		class Tablebase
+		{
+		public:
+			// Result for the player to move.
+			enum class Outcome : uint8_t
+			{
+				loss, draw, win
+			};
+
+			struct Entry
+			{
+				Outcome outcome;
+				// Plies until the game ends when the winner wins as soon as they can and the loser
+				// holds out as long as they can. For draws this is the number of empty cells.
+				uint8_t distance;
+			};
+
+			// Solves every position reachable on a board with the given settings. Throws
+			// std::invalid_argument if the board isn't supported (see isSupported) or the win length
+			// is invalid.
+			static Tablebase generate(uint8_t numColumns, uint8_t numRows, uint8_t winLength);
+
+			// Reads the tablebase written to path. Throws std::runtime_error if the file can't be read
+			// or isn't a tablebase, including when its header, bitmap and ranks don't agree.
+			explicit Tablebase(const std::string& path);
+
+			// Writes the tablebase to path. Throws std::runtime_error if the file can't be written.
+			void write(const std::string& path) const;
+
+			// Looks up the position of game, returning true and copying its result to entry if the
+			// game has the tablebase's settings and two players.
+			bool probe(const FourAcross& game, Entry& entry) const noexcept;
+
+			uint8_t getNumColumns() const noexcept;
+			uint8_t getNumRows() const noexcept;
+			uint8_t getWinLength() const noexcept;
+			// Number of reachable positions stored.
+			size_t getNumPositions() const noexcept;
+
+			// Returns true if boards of this size are small enough to number every position.
+			static bool isSupported(uint8_t numColumns, uint8_t numRows) noexcept;
+
+			// Largest count of position numbers a supported board may have.
+			static constexpr uint32_t maxIndices{uint32_t{1} << 25};
+		private:
+			Tablebase(uint8_t numColumns, uint8_t numRows, uint8_t winLength);
+
+			// Returns the number of the position of game.
+			uint32_t getIndex(const FourAcross& game) const noexcept;
+
+			uint8_t numColumns;
+			uint8_t numRows;
+			uint8_t winLength;
+			uint32_t numIndices;
+
+			// Bit i is set if position i is reachable.
+			std::vector<uint64_t> isReachable;
+			// Number of reachable positions before each block of blockWords words of isReachable.
+			std::vector<uint32_t> blockRanks;
+			// Encoded result of each reachable position, in position order.
+			std::vector<uint8_t> values;
+		};
+
+		inline uint8_t Tablebase::getNumColumns() const noexcept
+		{
+			return numColumns;
+		}
+
+		inline uint8_t Tablebase::getNumRows() const noexcept
+		{
+			return numRows;
+		}
+
+		inline uint8_t Tablebase::getWinLength() const noexcept
+		{
+			return winLength;
+		}
+
+		inline size_t Tablebase::getNumPositions() const noexcept
+		{
+			return values.size();
+		}
+	}
+}
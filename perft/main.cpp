@@ -0,0 +1,81 @@
+#include "four-across/perft/perft.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+
+using game::ConcurrentKeySet;
+using game::FourAcross;
+
+struct Options
+{
+	uint8_t numColumns;
+	uint8_t numRows;
+	uint8_t depth;
+	unsigned numThreads;
+	size_t maxPositions;
+};
+
+void runPerft(const Options& options)
+{
+	try
+	{
+		const FourAcross game{2, FourAcross::defaultFirstPlayer, options.numColumns, options.numRows};
+		ConcurrentKeySet positions{options.maxPositions};
+		const auto result = game::perft::countPositions(game, options.depth, options.numThreads, positions);
+
+		std::cout << "ply\tsequences\tpositions\n";
+		for (size_t ply = 0; ply < result.numSequences.size(); ++ply)
+		{
+			std::cout << ply + 1 << "\t" << result.numSequences[ply] << "\t" << result.numPositions[ply] << "\n";
+		}
+		if (!result.isComplete)
+		{
+			std::cout << "The position set filled up after " << positions.getNumKeys()
+				<< " positions, so position counts are too low\n";
+		}
+		std::cout << result.seconds << " s, " << result.sequencesPerSecond << " sequences/s with "
+			<< options.numThreads << " threads" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << "An error occurred while running perft: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+const char* const usage = "Usage: perft COLUMNS ROWS DEPTH THREADS [MAXPOSITIONS]";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+Options getOptions(int argc, char *argv[])
+{
+	if (argc != 5 && argc != 6) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	Options options{7, 6, 8, 1, size_t{1} << 24};
+	try{
+		// lexical_cast reads a uint8_t as a character
+		options.numColumns = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[1]));
+		options.numRows = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		options.depth = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[3]));
+		options.numThreads = boost::lexical_cast<unsigned>(argv[4]);
+		if (argc == 6)
+		{
+			options.maxPositions = boost::lexical_cast<size_t>(argv[5]);
+		}
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return options;
+}
+
+int main(int argc, char *argv[])
+{
+	runPerft(getOptions(argc, argv));
+}
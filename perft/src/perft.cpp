@@ -0,0 +1,178 @@
+#include "four-across/perft/perft.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <numeric>
+#include <thread>
+
+namespace game
+{
+	namespace perft
+	{
+		namespace
+		{
+			// Subtrees handed out per thread, so threads that finish early have more to take.
+			constexpr size_t subtreesPerThread{16};
+
+			struct Counter
+			{
+				Counter(uint8_t depth, ConcurrentKeySet& positions) :
+					numSequences(depth, 0),
+					numPositions(depth, 0),
+					isComplete{true},
+					positions{positions}
+				{
+				}
+
+				// Counts the position game reached ply turns after the start.
+				void count(const FourAcross& game, uint8_t ply) noexcept
+				{
+					++numSequences[ply - 1];
+					switch (positions.insert(game.getKey()))
+					{
+					case ConcurrentKeySet::InsertResult::inserted:
+						++numPositions[ply - 1];
+						break;
+					case ConcurrentKeySet::InsertResult::full:
+						isComplete = false;
+						break;
+					default:
+						break;
+					}
+				}
+
+				// Counts every position after the one game reached ply turns after the start.
+				void countAfter(FourAcross& game, uint8_t ply) noexcept
+				{
+					if (ply == numSequences.size() || game.hasWinner() || game.boardFull())
+					{
+						return;
+					}
+
+					const Board& board = game.getBoard();
+					for (uint8_t column = 0; column < game.getNumColumns(); ++column)
+					{
+						if (board.getColumnHeightUnchecked(column) < board.getNumRows())
+						{
+							game.makeMove(column);
+							count(game, ply + 1);
+							countAfter(game, ply + 1);
+							game.unmakeMove();
+						}
+					}
+				}
+
+				std::vector<uint64_t> numSequences;
+				std::vector<uint64_t> numPositions;
+				bool isComplete;
+				ConcurrentKeySet& positions;
+			};
+
+			// Counts positions up to splitPly turns in, and collects the moves to each unfinished
+			// position splitPly turns in as the subtrees to split.
+			void split(FourAcross& game, uint8_t ply, uint8_t splitPly, Counter& counter,
+				std::vector<uint8_t>& moves, std::vector<std::vector<uint8_t>>& subtrees)
+			{
+				if (game.hasWinner() || game.boardFull())
+				{
+					return;
+				}
+				if (ply == splitPly)
+				{
+					subtrees.push_back(moves);
+					return;
+				}
+
+				const Board& board = game.getBoard();
+				for (uint8_t column = 0; column < game.getNumColumns(); ++column)
+				{
+					if (board.getColumnHeightUnchecked(column) < board.getNumRows())
+					{
+						game.makeMove(column);
+						moves.push_back(column);
+						counter.count(game, ply + 1);
+						split(game, ply + 1, splitPly, counter, moves, subtrees);
+						moves.pop_back();
+						game.unmakeMove();
+					}
+				}
+			}
+		}
+
+		PerftResult countPositions(const FourAcross& game, uint8_t depth, unsigned numThreads, ConcurrentKeySet& positions)
+		{
+			const auto startTime = std::chrono::steady_clock::now();
+			numThreads = std::max(numThreads, 1u);
+
+			// split deep enough to give every thread several subtrees, but leave at least one ply to them
+			uint8_t splitPly = 0;
+			for (uint64_t numSubtrees = 1; numSubtrees < subtreesPerThread * numThreads && splitPly + 1 < depth; ++splitPly)
+			{
+				numSubtrees *= game.getNumColumns();
+			}
+
+			FourAcross start{game};
+			Counter splitCounter{depth, positions};
+			std::vector<uint8_t> moves;
+			std::vector<std::vector<uint8_t>> subtrees;
+			split(start, 0, splitPly, splitCounter, moves, subtrees);
+
+			std::vector<Counter> counters;
+			counters.reserve(numThreads);
+			for (unsigned i = 0; i < numThreads; ++i)
+			{
+				counters.emplace_back(depth, positions);
+			}
+
+			std::atomic<size_t> nextSubtree{0};
+			const auto countSubtrees = [&](Counter& counter)
+			{
+				FourAcross position{game};
+				for (size_t i = nextSubtree++; i < subtrees.size(); i = nextSubtree++)
+				{
+					for (auto column : subtrees[i])
+					{
+						position.makeMove(column);
+					}
+					counter.countAfter(position, splitPly);
+					for (size_t undone = 0; undone < subtrees[i].size(); ++undone)
+					{
+						position.unmakeMove();
+					}
+				}
+			};
+
+			std::vector<std::thread> threads;
+			for (unsigned i = 1; i < numThreads; ++i)
+			{
+				threads.emplace_back(countSubtrees, std::ref(counters[i]));
+			}
+			countSubtrees(counters.front());
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+
+			PerftResult result{};
+			result.numSequences = splitCounter.numSequences;
+			result.numPositions = splitCounter.numPositions;
+			result.isComplete = splitCounter.isComplete;
+			for (const auto& counter : counters)
+			{
+				for (uint8_t ply = 0; ply < depth; ++ply)
+				{
+					result.numSequences[ply] += counter.numSequences[ply];
+					result.numPositions[ply] += counter.numPositions[ply];
+				}
+				result.isComplete = result.isComplete && counter.isComplete;
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			const uint64_t totalSequences = std::accumulate(result.numSequences.begin(), result.numSequences.end(), uint64_t{0});
+			result.seconds = elapsed.count();
+			result.sequencesPerSecond = result.seconds > 0 ? totalSequences / result.seconds : 0;
+			return result;
+		}
+	}
+}
@@ -0,0 +1,80 @@
+#include "four-across/game/concurrentkeyset.hpp"
+#include "four-across/perft/perft.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+
+	{
+		ConcurrentKeySet keys{4};
+		assert(keys.insert(0) == ConcurrentKeySet::InsertResult::inserted);
+		assert(keys.insert(0) == ConcurrentKeySet::InsertResult::alreadyPresent);
+		assert(keys.insert(12) == ConcurrentKeySet::InsertResult::inserted);
+		assert(keys.insert(20) == ConcurrentKeySet::InsertResult::inserted);
+		assert(keys.insert(12) == ConcurrentKeySet::InsertResult::alreadyPresent);
+		assert(keys.insert(28) == ConcurrentKeySet::InsertResult::inserted);
+		assert(keys.insert(36) == ConcurrentKeySet::InsertResult::full);
+		assert(keys.contains(0) && keys.contains(12) && keys.contains(20) && keys.contains(28));
+		assert(!keys.contains(36));
+		assert(keys.getNumKeys() == 4);
+
+		keys.clear();
+		assert(keys.getNumKeys() == 0 && !keys.contains(12) && !keys.contains(0));
+	}
+
+	{
+		// threads adding overlapping keys each add every key once between them
+		ConcurrentKeySet keys{1 << 16};
+		std::vector<size_t> numInserted(4, 0);
+		std::vector<std::thread> threads;
+		for (size_t i = 0; i < numInserted.size(); ++i)
+		{
+			threads.emplace_back([&keys, &numInserted, i]()
+				{
+					for (uint64_t key = 0; key < 40000; ++key)
+					{
+						if (keys.insert(zobrist::mix(key)) == ConcurrentKeySet::InsertResult::inserted)
+						{
+							++numInserted[i];
+						}
+					}
+				});
+		}
+		for (auto& thread : threads)
+		{
+			thread.join();
+		}
+		assert(numInserted[0] + numInserted[1] + numInserted[2] + numInserted[3] == 40000);
+		assert(keys.getNumKeys() == 40000);
+	}
+
+	{
+		// the standard board's counts, the same with any number of threads
+		const uint64_t numSequences[] = {7, 49, 343, 2401, 16807, 117649, 823536};
+		const uint64_t numPositions[] = {7, 49, 238, 1120, 4263, 16422, 54859};
+		for (unsigned numThreads : {1u, 3u})
+		{
+			ConcurrentKeySet positions{1 << 17};
+			const auto result = perft::countPositions(FourAcross{2, 1, 7, 6}, 7, numThreads, positions);
+			assert(result.isComplete);
+			for (size_t ply = 0; ply < 7; ++ply)
+			{
+				assert(result.numSequences[ply] == numSequences[ply]);
+				assert(result.numPositions[ply] == numPositions[ply]);
+			}
+		}
+
+		// a full set is reported
+		ConcurrentKeySet positions{1000};
+		const auto result = perft::countPositions(FourAcross{2, 1, 7, 6}, 5, 2, positions);
+		assert(!result.isComplete);
+		assert(result.numSequences[4] == 16807);
+	}
+
+	std::cout << "tests passed\n";
+}
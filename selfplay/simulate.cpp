@@ -0,0 +1,107 @@
+#include "four-across/selfplay/simulation.hpp"
+
+#include <boost/algorithm/string/split.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include <iostream>
+#include <string>
+#include <thread>
+
+using game::FourAcross;
+using game::selfplay::Policy;
+using game::selfplay::SimulationSettings;
+
+void runSimulation(const SimulationSettings& settings)
+{
+	try
+	{
+		const auto result = game::selfplay::simulate(settings);
+
+		std::cout << result.numGames << " games in " << result.seconds << " s, "
+			<< result.gamesPerSecond << " games/s with " << settings.numThreads << " threads\n";
+		for (size_t player = 0; player < result.wins.size(); ++player)
+		{
+			const Policy policy = settings.policies[settings.policies.size() == 1 ? 0 : player];
+			std::cout << "player " << player + 1 << " (" << game::selfplay::getPolicyName(policy) << ") wins: "
+				<< result.wins[player] << " (" << 100.0 * result.wins[player] / result.numGames << "%)\n";
+		}
+		std::cout << "draws: " << result.draws << " (" << 100.0 * result.draws / result.numGames << "%)\n";
+
+		double meanLength = 0;
+		for (size_t length = 0; length < result.gameLengths.size(); ++length)
+		{
+			meanLength += static_cast<double>(length) * result.gameLengths[length] / result.numGames;
+		}
+		std::cout << "mean game length: " << meanLength << " turns\n";
+		std::cout << "turns\tgames\n";
+		for (size_t length = 0; length < result.gameLengths.size(); ++length)
+		{
+			if (result.gameLengths[length] != 0)
+			{
+				std::cout << length << "\t" << result.gameLengths[length] << "\n";
+			}
+		}
+		std::cout << std::flush;
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << "An error occurred while simulating games: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+const char* const usage =
+	"Usage: simulate GAMES COLUMNS ROWS PLAYERS POLICIES [THREADS] [WINLENGTH]\n"
+	"POLICIES is random, center or greedy, or one of them per player separated by commas";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+SimulationSettings getSettings(int argc, char *argv[])
+{
+	if (argc < 6 || argc > 8) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	SimulationSettings settings{};
+	settings.winLength = FourAcross::defaultWinLength;
+	settings.numThreads = std::max(std::thread::hardware_concurrency(), 1u);
+	settings.seed = 1;
+	try{
+		// lexical_cast reads a uint8_t as a character
+		settings.numGames = boost::lexical_cast<uint64_t>(argv[1]);
+		settings.numColumns = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		settings.numRows = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[3]));
+		settings.numPlayers = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[4]));
+
+		std::vector<std::string> policyNames;
+		boost::algorithm::split(policyNames, std::string{argv[5]}, [](char c) { return c == ','; });
+		for (const auto& name : policyNames)
+		{
+			settings.policies.push_back(game::selfplay::parsePolicy(name));
+		}
+
+		if (argc >= 7)
+		{
+			settings.numThreads = boost::lexical_cast<unsigned>(argv[6]);
+		}
+		if (argc == 8)
+		{
+			settings.winLength = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[7]));
+		}
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}catch(std::invalid_argument&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return settings;
+}
+
+int main(int argc, char *argv[])
+{
+	runSimulation(getSettings(argc, argv));
+}
@@ -0,0 +1,92 @@
+#include "four-across/selfplay/engine.hpp"
+
+#include <stdexcept>
+
+namespace game
+{
+	namespace selfplay
+	{
+		constexpr size_t Engine::searchBytes;
+
+		EngineConfig parseEngine(const std::string& name)
+		{
+			const size_t separator = name.find(':');
+			if (separator == std::string::npos)
+			{
+				return EngineConfig{EngineConfig::Kind::policy, parsePolicy(name), 0, 0};
+			}
+
+			const std::string kind = name.substr(0, separator);
+			const std::string setting = name.substr(separator + 1);
+			unsigned long long value = 0;
+			size_t numParsed = 0;
+			try
+			{
+				value = std::stoull(setting, &numParsed);
+			}
+			catch (const std::exception&)
+			{
+				numParsed = 0;
+			}
+			if (numParsed == 0 || numParsed != setting.size() || value == 0)
+			{
+				throw std::invalid_argument("parseEngine: invalid engine setting in " + name);
+			}
+
+			if (kind == "mcts")
+			{
+				return EngineConfig{EngineConfig::Kind::monteCarlo, Policy::random, value, 0};
+			}
+			if (kind == "alphabeta" && value <= solver::Solver::maxDepth)
+			{
+				return EngineConfig{EngineConfig::Kind::alphaBeta, Policy::random, 0, static_cast<uint8_t>(value)};
+			}
+			throw std::invalid_argument("parseEngine: unknown engine " + name);
+		}
+
+		std::string getEngineName(const EngineConfig& config)
+		{
+			switch (config.kind)
+			{
+			case EngineConfig::Kind::monteCarlo:
+				return "mcts:" + std::to_string(config.iterations);
+			case EngineConfig::Kind::alphaBeta:
+				return "alphabeta:" + std::to_string(config.depth);
+			case EngineConfig::Kind::policy:
+				break;
+			}
+			return getPolicyName(config.policy);
+		}
+
+		Engine::Engine(const EngineConfig& config, uint32_t seed) :
+			config{config},
+			engine{seed}
+		{
+			switch (config.kind)
+			{
+			case EngineConfig::Kind::monteCarlo:
+				monteCarlo.reset(new solver::MonteCarloTreeSearch{searchBytes, 1, seed});
+				break;
+			case EngineConfig::Kind::alphaBeta:
+				alphaBeta.reset(new solver::Solver{searchBytes});
+				break;
+			case EngineConfig::Kind::policy:
+				break;
+			}
+		}
+
+		uint8_t Engine::chooseMove(FourAcross& game)
+		{
+			switch (config.kind)
+			{
+			case EngineConfig::Kind::monteCarlo:
+				return monteCarlo->search(game, solver::MonteCarloLimits{0, config.iterations}).bestMove;
+			case EngineConfig::Kind::alphaBeta:
+				return alphaBeta->solve(game, solver::SearchLimits{config.depth, 0}).bestMove;
+			case EngineConfig::Kind::policy:
+				break;
+			}
+			return selfplay::chooseMove(config.policy, game, engine);
+		}
+	}
+}
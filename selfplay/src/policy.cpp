@@ -0,0 +1,160 @@
+#include "four-across/selfplay/policy.hpp"
+
+#include <algorithm>
+#include <array>
+#include <stdexcept>
+
+namespace game
+{
+	namespace selfplay
+	{
+		namespace
+		{
+			constexpr uint8_t noColumn{255};
+
+			// Entry i is true for column i.
+			using column_set_t = std::array<bool, 256>;
+
+			bool isPlayable(const Board& board, uint8_t column) noexcept
+			{
+				return board.getColumnHeightUnchecked(column) < board.getNumRows();
+			}
+
+			uint8_t chooseRandomMove(const FourAcross& game, std::default_random_engine& engine) noexcept
+			{
+				const Board& board = game.getBoard();
+				std::array<uint8_t, 256> playable;
+				uint8_t numPlayable = 0;
+				for (uint8_t column = 0; column < board.getNumColumns(); ++column)
+				{
+					if (isPlayable(board, column))
+					{
+						playable[numPlayable++] = column;
+					}
+				}
+				return playable[engine() % numPlayable];
+			}
+
+			uint32_t getCenterWeight(uint8_t column, uint8_t numColumns) noexcept
+			{
+				return std::min<uint32_t>(column, numColumns - 1 - column) + 1;
+			}
+
+			// Picks one of the columns set in allowed, weighted by getCenterWeight.
+			uint8_t chooseCenterBiasedMove(const column_set_t& allowed, uint8_t numColumns, std::default_random_engine& engine) noexcept
+			{
+				uint32_t totalWeight = 0;
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					totalWeight += allowed[column] ? getCenterWeight(column, numColumns) : 0;
+				}
+
+				uint32_t pick = engine() % totalWeight;
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					const uint32_t weight = allowed[column] ? getCenterWeight(column, numColumns) : 0;
+					if (pick < weight)
+					{
+						return column;
+					}
+					pick -= weight;
+				}
+				return numColumns - 1;
+			}
+
+			// Returns a column that wins at once for the player to move, or noColumn if none does.
+			uint8_t findWinningMove(FourAcross& game) noexcept
+			{
+				const Board& board = game.getBoard();
+				for (uint8_t column = 0; column < board.getNumColumns(); ++column)
+				{
+					if (!isPlayable(board, column))
+					{
+						continue;
+					}
+					game.makeMove(column);
+					const bool isWin = game.hasWinner();
+					game.unmakeMove();
+					if (isWin)
+					{
+						return column;
+					}
+				}
+				return noColumn;
+			}
+		}
+
+		Policy parsePolicy(const std::string& name)
+		{
+			if (name == "random")
+			{
+				return Policy::random;
+			}
+			if (name == "center")
+			{
+				return Policy::centerBiased;
+			}
+			if (name == "greedy")
+			{
+				return Policy::greedy;
+			}
+			throw std::invalid_argument("parsePolicy: unknown policy " + name);
+		}
+
+		const char* getPolicyName(Policy policy) noexcept
+		{
+			switch (policy)
+			{
+			case Policy::random:
+				return "random";
+			case Policy::centerBiased:
+				return "center";
+			case Policy::greedy:
+				return "greedy";
+			}
+			return "unknown";
+		}
+
+		uint8_t chooseMove(Policy policy, FourAcross& game, std::default_random_engine& engine) noexcept
+		{
+			if (policy == Policy::random)
+			{
+				return chooseRandomMove(game, engine);
+			}
+
+			const Board& board = game.getBoard();
+			const uint8_t numColumns = board.getNumColumns();
+			column_set_t allowed{};
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				allowed[column] = isPlayable(board, column);
+			}
+			if (policy == Policy::centerBiased)
+			{
+				return chooseCenterBiasedMove(allowed, numColumns, engine);
+			}
+
+			const uint8_t winningMove = findWinningMove(game);
+			if (winningMove != noColumn)
+			{
+				return winningMove;
+			}
+
+			// keep to the moves after which the next player can't win at once, if there are any
+			column_set_t safe{};
+			bool hasSafeMove = false;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				if (!allowed[column])
+				{
+					continue;
+				}
+				game.makeMove(column);
+				safe[column] = game.boardFull() || findWinningMove(game) == noColumn;
+				game.unmakeMove();
+				hasSafeMove = hasSafeMove || safe[column];
+			}
+			return chooseCenterBiasedMove(hasSafeMove ? safe : allowed, numColumns, engine);
+		}
+	}
+}
@@ -0,0 +1,105 @@
+#include "four-across/selfplay/simulation.hpp"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+
+namespace game
+{
+	namespace selfplay
+	{
+		namespace
+		{
+			// Games a thread takes at a time, few enough for the last batches to balance out.
+			constexpr uint64_t gamesPerBatch{256};
+		}
+
+		SimulationResult simulate(const SimulationSettings& settings)
+		{
+			if (settings.policies.size() != 1 && settings.policies.size() != settings.numPlayers)
+			{
+				throw std::invalid_argument("simulate: there must be one policy or one for each player");
+			}
+			// checks the settings
+			const FourAcross start{settings.numPlayers, FourAcross::defaultFirstPlayer,
+				settings.numColumns, settings.numRows, settings.winLength};
+
+			const auto startTime = std::chrono::steady_clock::now();
+			SimulationResult result{};
+			result.wins.resize(settings.numPlayers);
+			result.gameLengths.resize(settings.numColumns * settings.numRows + 1);
+
+			std::atomic<uint64_t> nextGame{0};
+			std::mutex resultMutex;
+			const auto runThread = [&]()
+			{
+				FourAcross game{start};
+				std::vector<uint64_t> wins(settings.numPlayers);
+				std::vector<uint64_t> gameLengths(result.gameLengths.size());
+				uint64_t draws = 0;
+				std::default_random_engine engine;
+				for (;;)
+				{
+					const uint64_t firstGame = nextGame.fetch_add(gamesPerBatch, std::memory_order_relaxed);
+					if (firstGame >= settings.numGames)
+					{
+						break;
+					}
+					const uint64_t lastGame = std::min(firstGame + gamesPerBatch, settings.numGames);
+					for (uint64_t gameIndex = firstGame; gameIndex < lastGame; ++gameIndex)
+					{
+						game = start;
+						engine.seed(static_cast<std::default_random_engine::result_type>(settings.seed + gameIndex));
+						while (!game.hasWinner() && !game.boardFull())
+						{
+							const uint8_t player = game.getCurrentPlayer();
+							const Policy policy = settings.policies[settings.policies.size() == 1 ? 0 : player - 1];
+							game.takeTurn(player, chooseMove(policy, game, engine));
+						}
+
+						if (game.hasWinner())
+						{
+							++wins[game.getWinner() - 1];
+						}
+						else
+						{
+							++draws;
+						}
+						++gameLengths[game.getNumTurns()];
+					}
+				}
+
+				std::lock_guard<std::mutex> lock{resultMutex};
+				for (size_t player = 0; player < wins.size(); ++player)
+				{
+					result.wins[player] += wins[player];
+				}
+				for (size_t length = 0; length < gameLengths.size(); ++length)
+				{
+					result.gameLengths[length] += gameLengths[length];
+				}
+				result.draws += draws;
+			};
+
+			std::vector<std::thread> helpers;
+			for (unsigned i = 1; i < settings.numThreads; ++i)
+			{
+				helpers.emplace_back(runThread);
+			}
+			runThread();
+			for (auto& helper : helpers)
+			{
+				helper.join();
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			result.numGames = settings.numGames;
+			result.seconds = elapsed.count();
+			result.gamesPerSecond = result.seconds > 0 ? result.numGames / result.seconds : 0;
+			return result;
+		}
+	}
+}
@@ -0,0 +1,215 @@
+#include "four-across/selfplay/tournament.hpp"
+#include "four-across/selfplay/workstealing.hpp"
+
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <stdexcept>
+
+namespace game
+{
+	namespace selfplay
+	{
+		namespace
+		{
+			double getExpectedScore(double elo) noexcept
+			{
+				return 1 / (1 + std::pow(10.0, -elo / 400));
+			}
+
+			struct GameRecord
+			{
+				std::vector<uint8_t> moves;
+				uint8_t winner;
+			};
+
+			// Plays a game from opening, engines[i] being player i + 1.
+			GameRecord playGame(const TournamentSettings& settings, const std::vector<uint8_t>& opening, Engine* engines[2])
+			{
+				FourAcross game{2, FourAcross::defaultFirstPlayer, settings.numColumns, settings.numRows, settings.winLength};
+				GameRecord record{opening, FourAcross::noWinner};
+				for (auto column : opening)
+				{
+					game.takeTurn(game.getCurrentPlayer(), column);
+				}
+				while (!game.hasWinner() && !game.boardFull())
+				{
+					const uint8_t player = game.getCurrentPlayer();
+					const uint8_t column = engines[player - 1]->chooseMove(game);
+					if (game.takeTurn(player, column) != FourAcross::TurnResult::success)
+					{
+						throw std::logic_error("playTournament: an engine chose a move that can't be played");
+					}
+					record.moves.push_back(column);
+				}
+				record.winner = game.getWinner();
+				return record;
+			}
+
+			void writeRecord(std::ostream& out, const TournamentSettings& settings, uint64_t pair, int round,
+				const EngineConfig& first, const EngineConfig& second, size_t openingLength, const GameRecord& record)
+			{
+				const char* const result = record.winner == 1 ? "1-0" : record.winner == 2 ? "0-1" : "1/2-1/2";
+				out << "[Event \"FourAcross tournament\"]\n"
+					<< "[Round \"" << pair + 1 << "." << round << "\"]\n"
+					<< "[Player1 \"" << getEngineName(first) << "\"]\n"
+					<< "[Player2 \"" << getEngineName(second) << "\"]\n"
+					<< "[Board \"" << int{settings.numColumns} << "x" << int{settings.numRows} << "\"]\n"
+					<< "[WinLength \"" << int{settings.winLength} << "\"]\n"
+					<< "[Opening \"";
+				for (size_t move = 0; move < openingLength; ++move)
+				{
+					out << (move ? " " : "") << int{record.moves[move]};
+				}
+				out << "\"]\n[Result \"" << result << "\"]\n\n";
+				for (size_t move = 0; move < record.moves.size(); ++move)
+				{
+					out << (move % 2 == 0 ? (move ? " " : "") + std::to_string(move / 2 + 1) + ". " : " ")
+						<< int{record.moves[move]};
+				}
+				out << (record.moves.empty() ? "" : " ") << result << "\n\n";
+			}
+		}
+
+		TournamentResult playTournament(const TournamentSettings& settings)
+		{
+			// checks the board settings
+			const FourAcross start{2, FourAcross::defaultFirstPlayer, settings.numColumns, settings.numRows, settings.winLength};
+			for (const auto& opening : settings.openings)
+			{
+				FourAcross game{start};
+				for (auto column : opening)
+				{
+					if (game.takeTurn(game.getCurrentPlayer(), column) != FourAcross::TurnResult::success)
+					{
+						throw std::invalid_argument("playTournament: an opening has a move that can't be played");
+					}
+				}
+				if (game.hasWinner() || game.boardFull())
+				{
+					throw std::invalid_argument("playTournament: an opening ends the game");
+				}
+			}
+
+			const auto startTime = std::chrono::steady_clock::now();
+			const unsigned numThreads = std::max(settings.numThreads, 1u);
+			std::vector<std::unique_ptr<Engine>> engines;
+			for (unsigned thread = 0; thread < numThreads; ++thread)
+			{
+				for (unsigned engine = 0; engine < 2; ++engine)
+				{
+					engines.emplace_back(new Engine{settings.engines[engine], settings.seed + 2 * thread + engine});
+				}
+			}
+
+			const double lowerBound = std::log(settings.sprt.beta / (1 - settings.sprt.alpha));
+			const double upperBound = std::log((1 - settings.sprt.beta) / settings.sprt.alpha);
+			const std::vector<uint8_t> noOpening;
+
+			TournamentResult result{};
+			std::mutex resultMutex;
+			runWorkStealing(settings.numPairs, numThreads, [&](unsigned thread, size_t pair)
+				{
+					{
+						std::lock_guard<std::mutex> lock{resultMutex};
+						if (result.decision != TournamentResult::Decision::none)
+						{
+							return;
+						}
+					}
+
+					const auto& opening = settings.openings.empty() ? noOpening : settings.openings[pair % settings.openings.size()];
+					Engine* const first = engines[2 * thread].get();
+					Engine* const second = engines[2 * thread + 1].get();
+					Engine* firstPlaysFirst[2] = {first, second};
+					Engine* secondPlaysFirst[2] = {second, first};
+					const GameRecord records[2] = {
+						playGame(settings, opening, firstPlaysFirst),
+						playGame(settings, opening, secondPlaysFirst)};
+
+					std::lock_guard<std::mutex> lock{resultMutex};
+					if (result.decision != TournamentResult::Decision::none)
+					{
+						// finished after the test decided: counting it would report totals and a ratio
+						// other than the ones the decision was made on
+						return;
+					}
+					for (int round = 0; round < 2; ++round)
+					{
+						// engines[0] is player 1 in the first game and player 2 in the second
+						const uint8_t winner = records[round].winner;
+						if (winner == FourAcross::noWinner)
+						{
+							++result.draws;
+						}
+						else
+						{
+							++(winner == round + 1 ? result.wins : result.losses);
+						}
+						if (settings.records)
+						{
+							writeRecord(*settings.records, settings, pair, round + 1,
+								settings.engines[round], settings.engines[1 - round], opening.size(), records[round]);
+						}
+					}
+					result.numGames += 2;
+
+					result.logLikelihoodRatio = getLogLikelihoodRatio(result.wins, result.draws, result.losses,
+						settings.sprt.elo0, settings.sprt.elo1);
+					if (settings.useSprt && result.logLikelihoodRatio <= lowerBound)
+					{
+						result.decision = TournamentResult::Decision::acceptedH0;
+					}
+					else if (settings.useSprt && result.logLikelihoodRatio >= upperBound)
+					{
+						result.decision = TournamentResult::Decision::acceptedH1;
+					}
+				});
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			result.score = result.numGames ? (result.wins + result.draws / 2.0) / result.numGames : 0.5;
+			result.eloDifference = getEloDifference(result.score);
+			result.seconds = elapsed.count();
+			result.gamesPerSecond = result.seconds > 0 ? result.numGames / result.seconds : 0;
+			return result;
+		}
+
+		double getLogLikelihoodRatio(uint64_t wins, uint64_t draws, uint64_t losses, double elo0, double elo1) noexcept
+		{
+			const double numGames = static_cast<double>(wins + draws + losses);
+			if (numGames == 0)
+			{
+				return 0;
+			}
+
+			const double score = (wins + draws / 2.0) / numGames;
+			const auto getVariance = [score, wins, losses](double draws)
+			{
+				return (wins * (1 - score) * (1 - score) + draws * (0.5 - score) * (0.5 - score) +
+					losses * score * score) / (wins + draws + losses);
+			};
+			// results that are all the same have no variance, so one more game is taken as a draw
+			double variance = getVariance(static_cast<double>(draws));
+			if (variance == 0)
+			{
+				variance = getVariance(draws + 1.0);
+			}
+
+			const double score0 = getExpectedScore(elo0);
+			const double score1 = getExpectedScore(elo1);
+			return (score1 - score0) * (2 * score - score0 - score1) * numGames / (2 * variance);
+		}
+
+		double getEloDifference(double score) noexcept
+		{
+			if (score <= 0 || score >= 1)
+			{
+				return score <= 0 ? -std::numeric_limits<double>::infinity() : std::numeric_limits<double>::infinity();
+			}
+			return -400 * std::log10(1 / score - 1);
+		}
+	}
+}
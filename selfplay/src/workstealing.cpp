@@ -0,0 +1,88 @@
+#include "four-across/selfplay/workstealing.hpp"
+
+#include <algorithm>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace game
+{
+	namespace selfplay
+	{
+		namespace
+		{
+			struct TaskQueue
+			{
+				std::mutex mutex;
+				std::deque<size_t> tasks;
+			};
+		}
+
+		void runWorkStealing(size_t numTasks, unsigned numThreads, const task_runner_t& runTask)
+		{
+			numThreads = std::max(numThreads, 1u);
+			std::vector<std::unique_ptr<TaskQueue>> queues;
+			for (unsigned thread = 0; thread < numThreads; ++thread)
+			{
+				queues.emplace_back(new TaskQueue{});
+			}
+			// later tasks go to the front, so each thread starts with its earliest tasks
+			for (size_t task = 0; task < numTasks; ++task)
+			{
+				queues[task % numThreads]->tasks.push_front(task);
+			}
+
+			const auto runThread = [&](unsigned thread) noexcept
+			{
+				for (;;)
+				{
+					bool hasTask = false;
+					size_t task = 0;
+					{
+						TaskQueue& own = *queues[thread];
+						std::lock_guard<std::mutex> lock{own.mutex};
+						if (!own.tasks.empty())
+						{
+							task = own.tasks.back();
+							own.tasks.pop_back();
+							hasTask = true;
+						}
+					}
+
+					// steal the task its owner would run last
+					for (unsigned offset = 1; offset < numThreads && !hasTask; ++offset)
+					{
+						TaskQueue& victim = *queues[(thread + offset) % numThreads];
+						std::lock_guard<std::mutex> lock{victim.mutex};
+						if (!victim.tasks.empty())
+						{
+							task = victim.tasks.front();
+							victim.tasks.pop_front();
+							hasTask = true;
+						}
+					}
+
+					// tasks are only ever taken, so once every queue is empty there is nothing left
+					if (!hasTask)
+					{
+						return;
+					}
+					runTask(thread, task);
+				}
+			};
+
+			std::vector<std::thread> helpers;
+			for (unsigned thread = 1; thread < numThreads; ++thread)
+			{
+				helpers.emplace_back(runThread, thread);
+			}
+			runThread(0);
+			for (auto& helper : helpers)
+			{
+				helper.join();
+			}
+		}
+	}
+}
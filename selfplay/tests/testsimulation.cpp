@@ -0,0 +1,108 @@
+#include "four-across/selfplay/policy.hpp"
+#include "four-across/selfplay/simulation.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::selfplay;
+
+	std::default_random_engine engine{3};
+
+	{
+		// the greedy policy takes a win, and otherwise blocks the next player's
+		FourAcross game{2, 1, 7, 6};
+		for (auto column : {1, 1, 2, 2, 3, 3})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		for (int i = 0; i < 50; ++i)
+		{
+			const uint8_t move = chooseMove(Policy::greedy, game, engine);
+			assert(move == 0 || move == 4);
+		}
+		assert(game.getNumTurns() == 6);
+
+		FourAcross blockOne{2, 1, 7, 6};
+		for (auto column : {6, 0, 6, 0, 6})
+		{
+			blockOne.takeTurn(blockOne.getCurrentPlayer(), column);
+		}
+		for (int i = 0; i < 50; ++i)
+		{
+			assert(chooseMove(Policy::greedy, blockOne, engine) == 6);
+		}
+	}
+
+	{
+		// every policy only picks columns that aren't full, and the center biased one favours the center
+		FourAcross game{2, 1, 5, 4};
+		for (auto column : {0, 0, 0, 0, 2, 2, 2, 2})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		uint32_t picks[5]{};
+		for (int i = 0; i < 3000; ++i)
+		{
+			for (auto policy : {Policy::random, Policy::centerBiased, Policy::greedy})
+			{
+				const uint8_t move = chooseMove(policy, game, engine);
+				assert(move == 1 || move == 3 || move == 4);
+				if (policy == Policy::centerBiased)
+				{
+					++picks[move];
+				}
+			}
+		}
+		assert(picks[1] > picks[4] && picks[3] > picks[4]);
+	}
+
+	{
+		// results are the same with any number of threads, and add up
+		SimulationSettings settings{3, 8, 7, 4, {Policy::greedy, Policy::centerBiased, Policy::random}, 3000, 1, 5};
+		const SimulationResult single = simulate(settings);
+		settings.numThreads = 3;
+		const SimulationResult threaded = simulate(settings);
+		assert(single.wins == threaded.wins && single.draws == threaded.draws);
+		assert(single.gameLengths == threaded.gameLengths);
+		assert(std::accumulate(single.wins.begin(), single.wins.end(), single.draws) == 3000);
+		assert(std::accumulate(single.gameLengths.begin(), single.gameLengths.end(), uint64_t{0}) == 3000);
+		// greedy against weaker policies wins most games
+		assert(single.wins[0] > single.wins[1] && single.wins[0] > single.wins[2]);
+
+		settings = SimulationSettings{2, 7, 6, 4, {Policy::random}, 20000, 2, 1};
+		const SimulationResult random = simulate(settings);
+		assert(random.gameLengths[6] == 0 && random.gameLengths[7] > 0);
+		std::cout << random.gamesPerSecond << " random games/s\n";
+	}
+
+	{
+		bool threw = false;
+		try
+		{
+			simulate(SimulationSettings{2, 7, 6, 4, {Policy::random, Policy::random, Policy::random}, 10, 1, 1});
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		threw = false;
+		try
+		{
+			parsePolicy("minimax");
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,139 @@
+#include "four-across/selfplay/tournament.hpp"
+#include "four-across/selfplay/workstealing.hpp"
+
+#include <atomic>
+#include <cassert>
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+	size_t countOccurrences(const std::string& text, const std::string& pattern)
+	{
+		size_t count = 0;
+		for (size_t found = text.find(pattern); found != std::string::npos; found = text.find(pattern, found + 1))
+		{
+			++count;
+		}
+		return count;
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::selfplay;
+
+	{
+		// every task runs once, and threads with quick tasks take over the slow ones' queued tasks
+		std::vector<std::atomic<int>> runs(200);
+		std::vector<unsigned> threads(runs.size());
+		runWorkStealing(runs.size(), 4, [&](unsigned thread, size_t task)
+			{
+				++runs[task];
+				threads[task] = thread;
+				if (task % 4 == 0)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(2));
+				}
+			});
+		size_t numStolen = 0;
+		for (size_t task = 0; task < runs.size(); ++task)
+		{
+			assert(runs[task] == 1);
+			numStolen += threads[task] != task % 4;
+		}
+		assert(numStolen > 0);
+
+		runWorkStealing(0, 3, [](unsigned, size_t) { assert(false); });
+	}
+
+	{
+		assert(getLogLikelihoodRatio(0, 0, 0, 0, 20) == 0);
+		assert(getLogLikelihoodRatio(60, 20, 20, 0, 20) > 0);
+		assert(getLogLikelihoodRatio(40, 20, 40, 0, 20) < 0);
+		assert(getLogLikelihoodRatio(10, 0, 0, 0, 20) > 0);
+		assert(getEloDifference(0.5) == 0);
+		assert(std::abs(getEloDifference(0.75) - 190.85) < 0.01);
+		assert(std::isinf(getEloDifference(1)));
+	}
+
+	{
+		// a clearly stronger engine is found stronger long before the pairs run out
+		TournamentSettings settings{};
+		settings.numColumns = 7;
+		settings.numRows = 6;
+		settings.winLength = 4;
+		settings.engines = {parseEngine("greedy"), parseEngine("random")};
+		settings.openings = {{3, 3}, {2, 4}, {4, 2}};
+		settings.numPairs = 1000;
+		settings.numThreads = 8;
+		settings.useSprt = true;
+		settings.sprt = {0, 20, 0.05, 0.05};
+		std::ostringstream records;
+		settings.records = &records;
+		TournamentResult result = playTournament(settings);
+		assert(result.decision == TournamentResult::Decision::acceptedH1);
+		// pairs that finish after the decision don't move the reported ratio back across the bounds
+		assert(result.logLikelihoodRatio >= std::log(0.95 / 0.05));
+		assert(result.numGames < 2 * settings.numPairs && result.numGames % 2 == 0);
+		assert(result.wins + result.losses + result.draws == result.numGames);
+		assert(countOccurrences(records.str(), "[Event ") == result.numGames);
+		assert(countOccurrences(records.str(), "[Opening \"3 3\"]") > 0);
+
+		// equal engines aren't found 100 Elo apart
+		settings.engines = {parseEngine("center"), parseEngine("center")};
+		settings.sprt = {0, 100, 0.05, 0.05};
+		settings.records = nullptr;
+		result = playTournament(settings);
+		assert(result.decision == TournamentResult::Decision::acceptedH0);
+		assert(result.logLikelihoodRatio <= std::log(0.05 / 0.95));
+
+		// without the test every pair is played, on searching engines too
+		settings.engines = {parseEngine("mcts:200"), parseEngine("alphabeta:4")};
+		settings.numPairs = 3;
+		settings.useSprt = false;
+		result = playTournament(settings);
+		assert(result.numGames == 6 && result.decision == TournamentResult::Decision::none);
+		std::cout << "mcts:200 against alphabeta:4 +" << result.wins << " -" << result.losses << " =" << result.draws << "\n";
+
+		bool threw = false;
+		try
+		{
+			settings.openings = {{0, 0, 0, 0, 0, 0, 0}};
+			playTournament(settings);
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	{
+		assert(parseEngine("mcts:500").kind == EngineConfig::Kind::monteCarlo);
+		assert(parseEngine("mcts:500").iterations == 500);
+		assert(getEngineName(parseEngine("alphabeta:8")) == "alphabeta:8");
+		for (auto name : {"mcts:", "mcts:0", "alphabeta:300", "minimax:4", "mcts:5x"})
+		{
+			bool threw = false;
+			try
+			{
+				parseEngine(name);
+			}
+			catch (const std::invalid_argument&)
+			{
+				threw = true;
+			}
+			assert(threw);
+		}
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,154 @@
+#include "four-across/selfplay/tournament.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using game::FourAcross;
+using game::selfplay::TournamentResult;
+using game::selfplay::TournamentSettings;
+
+struct Options
+{
+	TournamentSettings settings;
+	std::string openingsPath;
+	std::string recordsPath;
+};
+
+// Reads one opening per line, each move a column digit. Blank lines and lines starting with # are skipped.
+std::vector<std::vector<uint8_t>> readOpenings(const std::string& path)
+{
+	std::ifstream file{path};
+	if (!file)
+	{
+		throw std::runtime_error("couldn't open " + path);
+	}
+
+	std::vector<std::vector<uint8_t>> openings;
+	std::string line;
+	while (std::getline(file, line))
+	{
+		if (line.empty() || line[0] == '#')
+		{
+			continue;
+		}
+		std::vector<uint8_t> opening;
+		for (auto c : line)
+		{
+			if (c >= '0' && c <= '9')
+			{
+				opening.push_back(static_cast<uint8_t>(c - '0'));
+			}
+		}
+		openings.push_back(opening);
+	}
+	return openings;
+}
+
+void runTournament(Options& options)
+{
+	try
+	{
+		TournamentSettings& settings = options.settings;
+		if (!options.openingsPath.empty())
+		{
+			settings.openings = readOpenings(options.openingsPath);
+		}
+		std::ofstream records;
+		if (!options.recordsPath.empty())
+		{
+			records.open(options.recordsPath);
+			if (!records)
+			{
+				throw std::runtime_error("couldn't open " + options.recordsPath);
+			}
+			settings.records = &records;
+		}
+
+		const auto result = game::selfplay::playTournament(settings);
+
+		const auto& first = game::selfplay::getEngineName(settings.engines[0]);
+		const auto& second = game::selfplay::getEngineName(settings.engines[1]);
+		std::cout << first << " vs " << second << ": " << result.numGames << " games in " << result.seconds << " s, "
+			<< result.gamesPerSecond << " games/s with " << settings.numThreads << " threads\n"
+			<< "+" << result.wins << " -" << result.losses << " =" << result.draws
+			<< ", score " << result.score << ", Elo difference " << result.eloDifference << "\n"
+			<< "SPRT elo0 " << settings.sprt.elo0 << " elo1 " << settings.sprt.elo1
+			<< ": LLR " << result.logLikelihoodRatio << ", ";
+		switch (result.decision)
+		{
+		case TournamentResult::Decision::acceptedH0:
+			std::cout << "H0 accepted (" << first << " isn't " << settings.sprt.elo1 << " Elo stronger)\n";
+			break;
+		case TournamentResult::Decision::acceptedH1:
+			std::cout << "H1 accepted (" << first << " is " << settings.sprt.elo1 << " Elo stronger)\n";
+			break;
+		case TournamentResult::Decision::none:
+			std::cout << "no decision\n";
+			break;
+		}
+		std::cout << std::flush;
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << "An error occurred while running the tournament: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+const char* const usage =
+	"Usage: tournament COLUMNS ROWS ENGINE1 ENGINE2 MAXPAIRS THREADS [OPENINGS] [RECORDS]\n"
+	"ENGINE is random, center, greedy, mcts:ITERATIONS or alphabeta:DEPTH. OPENINGS is a file with\n"
+	"one opening of column digits per line, RECORDS the file to write game records to. The\n"
+	"tournament stops early once an SPRT of 0 against 20 Elo (alpha = beta = 0.05) decides.";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+Options getOptions(int argc, char *argv[])
+{
+	if (argc < 7 || argc > 9) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	Options options{};
+	TournamentSettings& settings = options.settings;
+	settings.winLength = FourAcross::defaultWinLength;
+	settings.useSprt = true;
+	settings.sprt = {0, 20, 0.05, 0.05};
+	settings.seed = 1;
+	try{
+		// lexical_cast reads a uint8_t as a character
+		settings.numColumns = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[1]));
+		settings.numRows = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		settings.engines[0] = game::selfplay::parseEngine(argv[3]);
+		settings.engines[1] = game::selfplay::parseEngine(argv[4]);
+		settings.numPairs = boost::lexical_cast<uint64_t>(argv[5]);
+		settings.numThreads = boost::lexical_cast<unsigned>(argv[6]);
+		if (argc >= 8)
+		{
+			options.openingsPath = argv[7];
+		}
+		if (argc == 9)
+		{
+			options.recordsPath = argv[8];
+		}
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}catch(std::invalid_argument&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return options;
+}
+
+int main(int argc, char *argv[])
+{
+	Options options = getOptions(argc, argv);
+	runTournament(options);
+}
@@ -1,23 +1,34 @@
+#include "four-across/networking/server/gamearchive.hpp"
 #include "four-across/networking/server/server.hpp"
 
 #include <boost/asio.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include <iostream>
+#include <memory>
+#include <string>
 
+using game::networking::server::GameArchive;
 using game::networking::server::Server;
 
 struct Options
 {
 	uint16_t port;
+	std::string archiveDirectory; // empty if finished games aren't kept
 };
 
 void runServer(const Options &options)
 {
 	try
 	{
+		std::unique_ptr<GameArchive> archive;
+		if (!options.archiveDirectory.empty())
+		{
+			archive.reset(new GameArchive{options.archiveDirectory});
+		}
+
 		boost::asio::io_service service;
-		Server server{service, "0.0.0.0", options.port};
+		Server server{service, "0.0.0.0", options.port, archive.get()};
 		service.run();
 	}
 	catch (std::exception &e)
@@ -26,19 +37,19 @@ void runServer(const Options &options)
 	}
 }
 
-const char* const usage = "Usage: server PORT";
+const char* const usage = "Usage: server PORT [ARCHIVE_DIRECTORY]";
 void printUsage() {
 	std::cout << usage << std::endl;
 }
 
 Options getOptions(int argc, char *argv[])
 {
-	if (argc != 2) {
+	if (argc != 2 && argc != 3) {
 		printUsage();
 		exit(EXIT_FAILURE);
 	}
 
-	Options options{8888};
+	Options options{8888, argc == 3 ? argv[2] : ""};
 	try{
 		options.port = boost::lexical_cast<uint16_t>(argv[1]);
 	}catch(boost::bad_lexical_cast&){
@@ -243,6 +243,7 @@ namespace game
 				message->data[1] = game->getNumColumns();
 				message->data[2] = game->getNumRows();
 				message->data[3] = game->getCurrentPlayer();
+				message->data[4] = game->getWinLength();
 
 				sendMessage(message);
 			}
@@ -0,0 +1,277 @@
+#include "four-across/networking/server/gamearchive.hpp"
+
+#include "logging.hpp"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace game
+{
+	namespace networking
+	{
+		namespace server
+		{
+			constexpr size_t GameArchive::defaultSegmentBytes;
+			constexpr std::chrono::milliseconds GameArchive::defaultSyncInterval;
+			constexpr size_t GameArchive::queueCapacity;
+			constexpr size_t GameArchive::maxRecordBytes;
+
+			namespace
+			{
+				constexpr char segmentMagic[8]{'F', 'A', 'G', 'A', 'M', 'E', 'S', '1'};
+
+				// Records are written once this many bytes are waiting, even if more are queued.
+				constexpr size_t maxBatchBytes{size_t{64} << 10};
+
+				// How long the writer sleeps when the queue is empty.
+				constexpr std::chrono::milliseconds idleWait{10};
+
+				std::string formatSegmentPath(const std::string& directory, uint32_t index)
+				{
+					char name[32];
+					std::snprintf(name, sizeof(name), "games-%06u.far", index);
+					return directory + "/" + name;
+				}
+
+				// Returns the highest index of the segments in directory, or 0 if there are none, so
+				// segments that were deleted from the middle aren't written again out of order.
+				// Returns 0 with errno set if the directory can't be read.
+				uint32_t findLastSegmentIndex(const std::string& directory) noexcept
+				{
+					DIR* const entries = ::opendir(directory.c_str());
+					if (entries == nullptr)
+					{
+						return 0;
+					}
+
+					uint32_t lastIndex = 0;
+					while (const dirent* entry = ::readdir(entries))
+					{
+						unsigned index = 0;
+						int length = 0;
+						const bool isSegment = std::sscanf(entry->d_name, "games-%u.far%n", &index, &length) == 1 &&
+							length == static_cast<int>(std::strlen(entry->d_name));
+						if (isSegment)
+						{
+							lastIndex = std::max<uint32_t>(lastIndex, index);
+						}
+					}
+					::closedir(entries);
+					return lastIndex;
+				}
+
+				// Writes all size bytes at data to file, returning false on an error.
+				bool writeAll(int file, const uint8_t* data, size_t size) noexcept
+				{
+					while (size > 0)
+					{
+						const ssize_t written = ::write(file, data, size);
+						if (written < 0)
+						{
+							if (errno == EINTR)
+							{
+								continue;
+							}
+							return false;
+						}
+						data += written;
+						size -= static_cast<size_t>(written);
+					}
+					return true;
+				}
+			}
+
+			GameArchive::GameArchive(const std::string& directory, size_t segmentBytes, std::chrono::milliseconds syncInterval) :
+				directory{directory},
+				segmentBytes{segmentBytes},
+				syncInterval{syncInterval},
+				numWritten{0},
+				numDropped{0},
+				isStopping{false},
+				batchRecords{0},
+				segmentFile{-1},
+				segmentIndex{0},
+				segmentSize{0},
+				hasUnsyncedWrites{false}
+			{
+				batch.reserve(maxBatchBytes + maxRecordBytes);
+				segmentIndex = findLastSegmentIndex(directory);
+				if (!openSegment())
+				{
+					throw std::runtime_error("GameArchive: can't create a segment in " + directory + ": " + std::strerror(errno));
+				}
+				writer = std::thread{&GameArchive::runWriter, this};
+			}
+
+			GameArchive::~GameArchive()
+			{
+				isStopping.store(true, std::memory_order_release);
+				writer.join();
+				closeSegment();
+			}
+
+			bool GameArchive::enqueue(const FourAcross& game) noexcept
+			{
+				QueuedRecord record;
+				record.size = 0;
+				try
+				{
+					record.size = static_cast<uint16_t>(writeGameRecord(game, record.bytes, maxRecordBytes));
+				}
+				catch (std::invalid_argument&)
+				{
+				}
+
+				// the queue's nodes are preallocated, so bounded_push fails rather than allocating when it's full
+				if (record.size == 0 || !queue.bounded_push(record))
+				{
+					numDropped.fetch_add(1, std::memory_order_relaxed);
+					return false;
+				}
+				return true;
+			}
+
+			std::string GameArchive::getSegmentPath() const
+			{
+				return formatSegmentPath(directory, segmentIndex);
+			}
+
+			void GameArchive::runWriter()
+			{
+				auto lastSync = std::chrono::steady_clock::now();
+				for (;;)
+				{
+					// everything queued before stopping was asked for is drained before returning
+					const bool isStopRequested = isStopping.load(std::memory_order_acquire);
+
+					// a pass takes at most a queue's worth of records, so syncs and stop requests are
+					// still seen while games keep arriving
+					size_t numPopped = 0;
+					QueuedRecord record;
+					while (numPopped < queueCapacity && queue.pop(record))
+					{
+						++numPopped;
+						const size_t pendingSize = segmentSize + batch.size();
+						if (pendingSize + record.size > segmentBytes && pendingSize > sizeof(segmentMagic))
+						{
+							// the next segment is created when the batch is written
+							writeBatch();
+							closeSegment();
+						}
+						else if (batch.size() >= maxBatchBytes)
+						{
+							writeBatch();
+						}
+						batch.insert(batch.end(), record.bytes, record.bytes + record.size);
+						++batchRecords;
+					}
+					writeBatch();
+
+					const auto now = std::chrono::steady_clock::now();
+					if (hasUnsyncedWrites && now - lastSync >= syncInterval)
+					{
+						::fdatasync(segmentFile);
+						hasUnsyncedWrites = false;
+						lastSync = now;
+					}
+
+					const bool isDrained = numPopped < queueCapacity;
+					if (isDrained && isStopRequested)
+					{
+						// the destructor syncs when it closes the segment
+						return;
+					}
+					if (isDrained)
+					{
+						std::this_thread::sleep_for(idleWait);
+					}
+				}
+			}
+
+			void GameArchive::writeBatch()
+			{
+				if (batch.empty())
+				{
+					return;
+				}
+
+				// a segment that couldn't be created is tried again with each batch
+				bool isWritten = false;
+				if (segmentFile < 0 && !openSegment())
+				{
+					print("GameArchive: can't create a segment in", directory, ":", std::strerror(errno), "\n");
+				}
+				else if (!writeAll(segmentFile, batch.data(), batch.size()))
+				{
+					print("GameArchive: can't write to", getSegmentPath(), ":", std::strerror(errno), "\n");
+				}
+				else
+				{
+					isWritten = true;
+					segmentSize += batch.size();
+					hasUnsyncedWrites = true;
+				}
+
+				(isWritten ? numWritten : numDropped).fetch_add(batchRecords, std::memory_order_relaxed);
+				batch.clear();
+				batchRecords = 0;
+			}
+
+			bool GameArchive::openSegment()
+			{
+				// existing segments are never opened for writing, so a name taken since the directory
+				// was read is skipped
+				uint32_t index = segmentIndex;
+				int file = -1;
+				do
+				{
+					++index;
+					file = ::open(formatSegmentPath(directory, index).c_str(),
+						O_WRONLY | O_CREAT | O_EXCL | O_APPEND | O_CLOEXEC, 0644);
+				} while (file < 0 && errno == EEXIST);
+
+				if (file < 0)
+				{
+					return false;
+				}
+				if (!writeAll(file, reinterpret_cast<const uint8_t*>(segmentMagic), sizeof(segmentMagic)))
+				{
+					const int error = errno;
+					::close(file);
+					errno = error;
+					return false;
+				}
+
+				segmentFile = file;
+				segmentIndex = index;
+				segmentSize = sizeof(segmentMagic);
+				hasUnsyncedWrites = true;
+				return true;
+			}
+
+			void GameArchive::closeSegment()
+			{
+				if (segmentFile < 0)
+				{
+					return;
+				}
+				if (hasUnsyncedWrites)
+				{
+					::fdatasync(segmentFile);
+					hasUnsyncedWrites = false;
+				}
+				::close(segmentFile);
+				segmentFile = -1;
+				// the next segment starts with its magic
+				segmentSize = sizeof(segmentMagic);
+			}
+		}
+	}
+}
@@ -19,10 +19,12 @@ namespace game
 	{
 		namespace server
 		{
-			GameLobby::GameLobby(uint8_t maxPlayers) :
+			GameLobby::GameLobby(uint8_t maxPlayers, uint8_t winLength, GameArchive* archive) :
 				lobbyIsOpen{false},
 				isPlayingGame{false},
+				archive{archive},
 				maxPlayers{maxPlayers},
+				winLength{winLength},
 				numReady{0},
 				numPlayers{0}
 			{
@@ -106,6 +108,12 @@ namespace game
 					gameEnded(game->noWinner);
 				}
 
+				// the archive only copies the moves, so this never waits for the disk
+				if (archive && game->getNumTurns() > 0 && !archive->enqueue(*game))
+				{
+					print("GameLobby [", this, "]: archive is behind, game was dropped\n");
+				}
+
 				game.reset();
 
 				isPlayingGame = false;
@@ -180,7 +188,7 @@ namespace game
 						std::uniform_int_distribution<unsigned short> dist(1u, static_cast<unsigned short>(maxPlayers));
 						auto first = static_cast<uint8_t>(dist(engine));
 
-						game.reset(new FourAcross{maxPlayers, first});
+						game.reset(new FourAcross{maxPlayers, first, Board::minColumns, Board::minRows, winLength});
 
 						// start if all players are ready
 						startGame();
@@ -196,27 +204,20 @@ namespace game
 					return;
 				}
 
-				try
-				{
-					const auto result = game->takeTurn(connection->getId(), column);
+				// bad columns come back as a TurnResult, takeTurn doesn't throw
+				const auto result = game->takeTurn(connection->getId(), column);
 
-					// notify other players that there was a move
-					tookTurn(connection->getId(), column, result);
+				// notify other players that there was a move
+				tookTurn(connection->getId(), column, result);
 
-					if (game->hasWinner() || game->boardFull())
-					{
-						onGameOver();
-					}
-					else if (result == FourAcross::TurnResult::success)
-					{
-						// if turn was successful, tell next player to take turn
-						takeTurn(game->getCurrentPlayer());
-					}
+				if (game->hasWinner() || game->boardFull())
+				{
+					onGameOver();
 				}
-				catch (std::exception& error)
+				else if (result == FourAcross::TurnResult::success)
 				{
-					printDebug("GameLobby[", this, "]::onTakeTurn: error taking turn: ", error.what(), "\n");
-					tookTurn(connection->getId(), column, FourAcross::TurnResult::error);
+					// if turn was successful, tell next player to take turn
+					takeTurn(game->getCurrentPlayer());
 				}
 			}
 
@@ -22,11 +22,13 @@ namespace game
 		{
 			Server::Server(
 				boost::asio::io_service & ioService,
-				std::string address, uint16_t port
+				std::string address, uint16_t port,
+				GameArchive* archive
 			) :
 				ioService{ioService},
 				acceptor{ioService, tcp::endpoint{address_v4::from_string(address), port}},
 				queueUpdateTimer{ioService},
+				archive{archive},
 				lastQueueSize{0}
 			{
 				waitForConnections();
@@ -132,7 +134,7 @@ namespace game
 			GameLobby * Server::makeNewLobby()
 			{
 				print("Making new lobby\n");
-				lobbies.emplace_back(new GameLobby{}); // make a new lobby using default number of max players
+				lobbies.emplace_back(new GameLobby{FourAcross::minNumPlayers, FourAcross::defaultWinLength, archive}); // make a new lobby using default number of max players
 				auto lobby = lobbies.back().get();
 				lobby->addLobbyAvailableHandler(std::bind(&Server::onLobbyAvailable, this, std::placeholders::_1));
 				lobby->start();
@@ -0,0 +1,155 @@
+#include "four-across/game/game.hpp"
+#include "four-across/game/gamerecord.hpp"
+#include "four-across/networking/server/gamearchive.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using game::networking::server::GameArchive;
+
+	std::default_random_engine engine{5};
+	const auto playRandomGame = [&engine](FourAcross game)
+	{
+		while (!game.hasWinner() && !game.boardFull())
+		{
+			game.takeTurn(game.getCurrentPlayer(), engine() % game.getNumColumns());
+		}
+		return game;
+	};
+
+	char directoryName[] = "/tmp/testgamearchive-XXXXXX";
+	const char* const createdDirectory = mkdtemp(directoryName);
+	assert(createdDirectory != nullptr);
+	if (createdDirectory == nullptr)
+	{
+		// the template itself mustn't be written to or removed
+		return 1;
+	}
+	const std::string directory{directoryName};
+
+	const auto readSegment = [&directory](int index)
+	{
+		char name[32];
+		std::snprintf(name, sizeof(name), "/games-%06d.far", index);
+		std::ifstream file{directory + name, std::ios::binary};
+		return std::vector<uint8_t>{std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{}};
+	};
+
+	std::vector<FourAcross> games;
+	for (int i = 0; i < 200; ++i)
+	{
+		games.push_back(playRandomGame(FourAcross{2, 1, 7, 6}));
+	}
+
+	{
+		// every game is written, in order, across segments of at most 256 bytes
+		{
+			GameArchive archive{directory, 256, std::chrono::milliseconds{5}};
+			for (const auto& game : games)
+			{
+				const bool isQueued = archive.enqueue(game);
+				assert(isQueued);
+			}
+		}
+
+		size_t numRead = 0;
+		int numSegments = 0;
+		for (int index = 1;; ++index)
+		{
+			const auto segment = readSegment(index);
+			if (segment.empty())
+			{
+				break;
+			}
+			++numSegments;
+			assert(segment.size() <= 256);
+			assert(std::memcmp(segment.data(), "FAGAMES1", 8) == 0);
+
+			size_t offset = 8;
+			assert(offset < segment.size());
+			while (offset < segment.size())
+			{
+				const GameRecordReader reader{segment.data() + offset, segment.size() - offset};
+				const FourAcross read = readGameRecord(segment.data() + offset, segment.size() - offset);
+				assert(numRead < games.size());
+				assert(read.getMoves() == games[numRead].getMoves());
+				assert(read.getKey() == games[numRead].getKey());
+				offset += reader.getRecordSize();
+				++numRead;
+			}
+			assert(offset == segment.size());
+		}
+		assert(numRead == games.size());
+		assert(numSegments > 1);
+
+		// an archive opened again starts after the existing segments instead of changing them
+		const auto firstSegment = readSegment(1);
+		{
+			GameArchive archive{directory};
+			const bool isQueued = archive.enqueue(games[0]);
+			assert(isQueued);
+			assert(archive.getNumWritten() <= 1);
+		}
+		assert(readSegment(1) == firstSegment);
+		const auto lastSegment = readSegment(numSegments + 1);
+		assert(lastSegment.size() == 8 + GameRecordWriter::getRecordSize(games[0].getNumTurns()));
+
+		// removing an old segment doesn't make the next archive fill the hole ahead of newer ones
+		char removedName[32];
+		std::snprintf(removedName, sizeof(removedName), "/games-%06d.far", 2);
+		std::remove((directory + removedName).c_str());
+		{
+			GameArchive archive{directory};
+		}
+		assert(readSegment(2).empty());
+		assert(readSegment(numSegments + 2).size() == 8);
+	}
+
+	{
+		// counts match what was enqueued, and games that can't be recorded are dropped
+		GameArchive archive{directory};
+		size_t numQueued = 0;
+		for (int i = 0; i < 5000; ++i)
+		{
+			numQueued += archive.enqueue(games[i % games.size()]);
+		}
+		const bool isTooWideQueued = archive.enqueue(FourAcross{2, 1, 17, 4});
+		assert(!isTooWideQueued);
+		while (archive.getNumWritten() < numQueued)
+		{
+			std::this_thread::yield();
+		}
+		assert(archive.getNumWritten() == numQueued);
+		assert(archive.getNumDropped() == 5001 - numQueued);
+	}
+
+	{
+		// a missing directory is reported by the constructor
+		bool threw = false;
+		try
+		{
+			GameArchive archive{directory + "/missing"};
+		}
+		catch (const std::runtime_error&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::system(("rm -r " + directory).c_str());
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,101 @@
+#include "four-across/solver/batchsolver.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using game::solver::BatchSolver;
+using game::solver::SearchLimits;
+using game::solver::SearchResult;
+
+struct Options
+{
+	unsigned numThreads;
+	uint8_t depth;
+	size_t numPositions;
+};
+
+constexpr uint8_t numColumns{7};
+constexpr uint8_t numRows{6};
+constexpr int maxOpeningMoves{12};
+
+// Random positions of a standard 7x6 game that haven't been won yet.
+std::vector<std::vector<uint8_t>> makePositions(size_t numPositions)
+{
+	std::default_random_engine engine{1};
+	std::vector<std::vector<uint8_t>> positions;
+	positions.reserve(numPositions);
+	while (positions.size() < numPositions)
+	{
+		game::FourAcross game{2, 1, numColumns, numRows};
+		std::vector<uint8_t> moves;
+		const int numMoves = engine() % (maxOpeningMoves + 1);
+		for (int i = 0; i < numMoves && !game.hasWinner(); ++i)
+		{
+			const uint8_t column = engine() % numColumns;
+			if (game.takeTurn(game.getCurrentPlayer(), column) == game::FourAcross::TurnResult::success)
+			{
+				moves.push_back(column);
+			}
+		}
+		if (!game.hasWinner())
+		{
+			positions.push_back(std::move(moves));
+		}
+	}
+	return positions;
+}
+
+void runBenchmark(const Options& options)
+{
+	const auto positions = makePositions(options.numPositions);
+	BatchSolver solver{options.numThreads};
+
+	uint64_t numNodes{0};
+	const auto startTime = std::chrono::steady_clock::now();
+	solver.solve(positions.data(), positions.size(), numColumns, numRows, game::FourAcross::defaultWinLength,
+		SearchLimits{options.depth, 0}, [&numNodes](size_t, const SearchResult& result)
+		{
+			numNodes += result.numNodes;
+		});
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+
+	std::cout << positions.size() << " positions at depth " << static_cast<int>(options.depth)
+		<< " with " << solver.getNumThreads() << " threads in " << elapsed.count() << " s\n"
+		<< positions.size() / elapsed.count() << " positions/s, "
+		<< numNodes / elapsed.count() << " nodes/s" << std::endl;
+}
+
+const char* const usage = "Usage: solverbenchmark THREADS DEPTH POSITIONS";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+Options getOptions(int argc, char *argv[])
+{
+	if (argc != 4) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	Options options{1, 8, 1000};
+	try{
+		options.numThreads = boost::lexical_cast<unsigned>(argv[1]);
+		// lexical_cast reads a uint8_t as a character
+		options.depth = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		options.numPositions = boost::lexical_cast<size_t>(argv[3]);
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return options;
+}
+
+int main(int argc, char *argv[])
+{
+	runBenchmark(getOptions(argc, argv));
+}
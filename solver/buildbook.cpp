@@ -0,0 +1,145 @@
+#include "four-across/solver/batchsolver.hpp"
+#include "four-across/solver/openingbook.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+using game::FourAcross;
+using game::solver::BatchSolver;
+using game::solver::OpeningBook;
+using game::solver::SearchLimits;
+using game::solver::SearchResult;
+
+struct Options
+{
+	uint8_t numColumns;
+	uint8_t numRows;
+	uint8_t winLength;
+	uint8_t maxPly;
+	uint8_t depth;
+	unsigned numThreads;
+	std::string path;
+};
+
+// Positions reachable in at most maxPly turns, once each counting mirror images as the same, as the
+// moves leading to them.
+struct Enumeration
+{
+	std::vector<std::vector<uint8_t>> moveLists;
+	std::vector<game::zobrist::CanonicalKey> keys;
+	std::unordered_set<uint64_t> seen;
+};
+
+void enumerate(FourAcross& game, uint8_t maxPly, std::vector<uint8_t>& moves, Enumeration& enumeration)
+{
+	const game::zobrist::CanonicalKey key = game.getCanonicalKey();
+	if (game.hasWinner() || game.boardFull() || !enumeration.seen.insert(key.key).second)
+	{
+		return;
+	}
+	enumeration.moveLists.push_back(moves);
+	enumeration.keys.push_back(key);
+	if (moves.size() == maxPly)
+	{
+		return;
+	}
+
+	for (uint8_t column = 0; column < game.getNumColumns(); ++column)
+	{
+		if (game.getBoard().getColumnHeight(column) < game.getNumRows())
+		{
+			game.makeMove(column);
+			moves.push_back(column);
+			enumerate(game, maxPly, moves, enumeration);
+			moves.pop_back();
+			game.unmakeMove();
+		}
+	}
+}
+
+void buildBook(const Options& options)
+{
+	try
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+
+		FourAcross game{2, FourAcross::defaultFirstPlayer, options.numColumns, options.numRows, options.winLength};
+		Enumeration enumeration;
+		std::vector<uint8_t> moves;
+		enumerate(game, options.maxPly, moves, enumeration);
+		enumeration.seen.clear();
+		std::cout << enumeration.moveLists.size() << " positions up to ply " << static_cast<int>(options.maxPly) << std::endl;
+
+		BatchSolver solver{options.numThreads};
+		std::vector<OpeningBook::Position> positions;
+		positions.reserve(enumeration.moveLists.size());
+		solver.solve(enumeration.moveLists.data(), enumeration.moveLists.size(),
+			options.numColumns, options.numRows, options.winLength, SearchLimits{options.depth, 0},
+			[&](size_t index, const SearchResult& result)
+			{
+				const uint8_t depth = result.isSolved ? OpeningBook::solvedDepth : result.depth;
+				const game::zobrist::CanonicalKey& key = enumeration.keys[index];
+				const uint8_t bestMove = key.isMirrored && result.bestMove < options.numColumns ?
+					options.numColumns - 1 - result.bestMove :
+					result.bestMove;
+				positions.push_back({key.key, {result.score, bestMove, depth}});
+				if (positions.size() % 10000 == 0)
+				{
+					std::cout << positions.size() << " positions solved" << std::endl;
+				}
+			});
+
+		OpeningBook::write(options.path, options.numColumns, options.numRows, options.winLength, options.maxPly,
+			std::move(positions));
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+		std::cout << "Wrote " << options.path << " in " << elapsed.count() << " s, "
+			<< enumeration.moveLists.size() / elapsed.count() << " positions/s" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << "An error occurred while building the book: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+const char* const usage = "Usage: buildbook COLUMNS ROWS WINLENGTH PLIES DEPTH THREADS FILE\n"
+	"Solves every position up to PLIES turns in, searching DEPTH plies deep (0 to solve exactly).";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+Options getOptions(int argc, char *argv[])
+{
+	if (argc != 8) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	Options options{7, 6, 4, 8, 0, 1, ""};
+	try{
+		// lexical_cast reads a uint8_t as a character
+		options.numColumns = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[1]));
+		options.numRows = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		options.winLength = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[3]));
+		options.maxPly = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[4]));
+		options.depth = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[5]));
+		options.numThreads = boost::lexical_cast<unsigned>(argv[6]);
+		options.path = argv[7];
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return options;
+}
+
+int main(int argc, char *argv[])
+{
+	buildBook(getOptions(argc, argv));
+}
@@ -0,0 +1,68 @@
+#include "four-across/solver/tablebase.hpp"
+
+#include <boost/lexical_cast.hpp>
+
+#include <chrono>
+#include <iostream>
+#include <string>
+
+using game::solver::Tablebase;
+
+struct Options
+{
+	uint8_t numColumns;
+	uint8_t numRows;
+	uint8_t winLength;
+	std::string path;
+};
+
+void buildTablebase(const Options& options)
+{
+	try
+	{
+		const auto startTime = std::chrono::steady_clock::now();
+		const Tablebase tablebase = Tablebase::generate(options.numColumns, options.numRows, options.winLength);
+		tablebase.write(options.path);
+
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+		std::cout << "Wrote " << tablebase.getNumPositions() << " positions to " << options.path
+			<< " in " << elapsed.count() << " s" << std::endl;
+	}
+	catch (std::exception &e)
+	{
+		std::cerr << "An error occurred while building the tablebase: " << e.what() << "\n";
+		exit(EXIT_FAILURE);
+	}
+}
+
+const char* const usage = "Usage: buildtablebase COLUMNS ROWS WINLENGTH FILE";
+void printUsage() {
+	std::cout << usage << std::endl;
+}
+
+Options getOptions(int argc, char *argv[])
+{
+	if (argc != 5) {
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	Options options{5, 4, 4, ""};
+	try{
+		// lexical_cast reads a uint8_t as a character
+		options.numColumns = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[1]));
+		options.numRows = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[2]));
+		options.winLength = static_cast<uint8_t>(boost::lexical_cast<unsigned>(argv[3]));
+		options.path = argv[4];
+	}catch(boost::bad_lexical_cast&){
+		printUsage();
+		exit(EXIT_FAILURE);
+	}
+
+	return options;
+}
+
+int main(int argc, char *argv[])
+{
+	buildTablebase(getOptions(argc, argv));
+}
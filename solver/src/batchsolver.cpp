@@ -0,0 +1,206 @@
+#include "four-across/solver/batchsolver.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr size_t BatchSolver::defaultTableBytesPerThread;
+
+		BatchSolver::Worker::Worker(size_t tableBytes) :
+			solver{tableBytes, 1},
+			game{}
+		{
+		}
+
+		BatchSolver::BatchSolver(unsigned numThreads, size_t tableBytesPerThread) :
+			batchNumber{0},
+			numPositions{0},
+			nextPosition{0},
+			numBusyWorkers{0},
+			loadPosition{nullptr},
+			limits{},
+			isShuttingDown{false}
+		{
+			numThreads = std::max(numThreads, 1u);
+			for (unsigned i = 0; i < numThreads; ++i)
+			{
+				workers.emplace_back(new Worker{tableBytesPerThread});
+			}
+			for (auto& worker : workers)
+			{
+				threads.emplace_back(&BatchSolver::runWorker, this, std::ref(*worker));
+			}
+		}
+
+		BatchSolver::~BatchSolver()
+		{
+			{
+				std::lock_guard<std::mutex> lock{mutex};
+				isShuttingDown = true;
+			}
+			batchStarted.notify_all();
+			for (auto& thread : threads)
+			{
+				thread.join();
+			}
+		}
+
+		void BatchSolver::solve(const GameSnapshot* positions, size_t numPositions, const SearchLimits& limits,
+			const result_handler_t& onResult)
+		{
+			const bool areTwoPlayerGames = std::all_of(positions, positions + numPositions, [](const GameSnapshot& snapshot)
+				{
+					return snapshot.numPlayers == 2;
+				});
+			if (!areTwoPlayerGames)
+			{
+				throw std::invalid_argument("BatchSolver::solve: only two player games can be solved");
+			}
+
+			const position_loader_t loadSnapshot = [positions](Worker& worker, size_t index)
+			{
+				// restoring reuses the worker's game when the settings match
+				worker.game.restore(positions[index]);
+			};
+			run(numPositions, limits, loadSnapshot, onResult);
+		}
+
+		void BatchSolver::solve(const std::vector<uint8_t>* moveLists, size_t numPositions,
+			uint8_t numColumns, uint8_t numRows, uint8_t winLength, const SearchLimits& limits,
+			const result_handler_t& onResult)
+		{
+			// check the settings here rather than failing on every thread
+			FourAcross{2, FourAcross::defaultFirstPlayer, numColumns, numRows, winLength};
+
+			const position_loader_t loadMoves = [=](Worker& worker, size_t index)
+			{
+				FourAcross& game = worker.game;
+				if (game.getNumColumns() != numColumns || game.getNumRows() != numRows ||
+					game.getWinLength() != winLength || game.getNumPlayers() != 2)
+				{
+					game = FourAcross{2, FourAcross::defaultFirstPlayer, numColumns, numRows, winLength};
+				}
+				else
+				{
+					// taking the last position's moves back is cheaper than making a new game
+					while (game.undoTurn())
+					{
+					}
+				}
+
+				for (auto column : moveLists[index])
+				{
+					game.takeTurn(game.getCurrentPlayer(), column);
+				}
+			};
+			run(numPositions, limits, loadMoves, onResult);
+		}
+
+		void BatchSolver::run(size_t numPositions, const SearchLimits& limits, const position_loader_t& loadPosition,
+			const result_handler_t& onResult)
+		{
+			{
+				std::lock_guard<std::mutex> lock{mutex};
+				this->numPositions = numPositions;
+				this->nextPosition = 0;
+				this->loadPosition = &loadPosition;
+				this->limits = limits;
+				results.assign(numPositions, SearchResult{});
+				isResultReady.assign(numPositions, false);
+				error = nullptr;
+				++batchNumber;
+			}
+			batchStarted.notify_all();
+
+			// workers use loadPosition until they finish their current position, so the batch must be
+			// stopped and drained before leaving early
+			const auto stopBatch = [this](std::unique_lock<std::mutex>& lock)
+			{
+				nextPosition = this->numPositions;
+				resultReady.wait(lock, [this]()
+					{
+						return numBusyWorkers == 0;
+					});
+			};
+
+			for (size_t index = 0; index < numPositions; ++index)
+			{
+				SearchResult result;
+				{
+					std::unique_lock<std::mutex> lock{mutex};
+					resultReady.wait(lock, [this, index]()
+						{
+							return isResultReady[index] || error != nullptr;
+						});
+					if (error != nullptr)
+					{
+						stopBatch(lock);
+						std::rethrow_exception(error);
+					}
+					result = results[index];
+				}
+
+				try
+				{
+					onResult(index, result);
+				}
+				catch (...)
+				{
+					std::unique_lock<std::mutex> lock{mutex};
+					stopBatch(lock);
+					throw;
+				}
+			}
+		}
+
+		void BatchSolver::runWorker(Worker& worker)
+		{
+			uint64_t lastBatch{0};
+			std::unique_lock<std::mutex> lock{mutex};
+			while (true)
+			{
+				batchStarted.wait(lock, [this, lastBatch]()
+					{
+						return isShuttingDown || batchNumber != lastBatch;
+					});
+				if (isShuttingDown)
+				{
+					return;
+				}
+				lastBatch = batchNumber;
+
+				while (nextPosition < numPositions && error == nullptr)
+				{
+					const size_t index = nextPosition++;
+					++numBusyWorkers;
+					lock.unlock();
+
+					SearchResult result{};
+					std::exception_ptr failure;
+					try
+					{
+						(*loadPosition)(worker, index);
+						result = worker.solver.solve(worker.game, limits);
+					}
+					catch (...)
+					{
+						failure = std::current_exception();
+					}
+
+					lock.lock();
+					--numBusyWorkers;
+					if (failure != nullptr && error == nullptr)
+					{
+						error = failure;
+					}
+					results[index] = result;
+					isResultReady[index] = true;
+					resultReady.notify_all();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,291 @@
+#include "four-across/solver/knowledgeevaluator.hpp"
+
+#include "four-across/solver/solver.hpp"
+
+#include <bitset>
+#include <stdexcept>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr size_t KnowledgeEvaluator::maxColumns;
+		constexpr size_t KnowledgeEvaluator::maxLines;
+
+		namespace
+		{
+			// Cells are numbered column * numRows + row, as in Board.
+			uint64_t getCellBit(uint8_t column, uint8_t row, uint8_t numRows) noexcept
+			{
+				return uint64_t{1} << (column * numRows + row);
+			}
+
+			bool hasOneBit(uint64_t bits) noexcept
+			{
+				return bits != 0 && (bits & (bits - 1)) == 0;
+			}
+		}
+
+		KnowledgeEvaluator::KnowledgeEvaluator(uint8_t numColumns, uint8_t numRows, uint8_t winLength) :
+			numColumns{numColumns},
+			numRows{numRows},
+			winLength{winLength}
+		{
+			if (numColumns * numRows > 64)
+			{
+				throw std::invalid_argument("KnowledgeEvaluator: boards of more than 64 cells aren't supported");
+			}
+			if (winLength < FourAcross::minWinLength || winLength > numColumns)
+			{
+				throw std::invalid_argument("KnowledgeEvaluator: invalid win length");
+			}
+
+			// every run of winLength cells going up, right, up and right, and down and right
+			const int directions[4][2] = {{0, 1}, {1, 0}, {1, 1}, {1, -1}};
+			for (const auto& direction : directions)
+			{
+				for (int column = 0; column < numColumns; ++column)
+				{
+					for (int row = 0; row < numRows; ++row)
+					{
+						const int lastColumn = column + direction[0] * (winLength - 1);
+						const int lastRow = row + direction[1] * (winLength - 1);
+						if (lastColumn >= numColumns || lastRow < 0 || lastRow >= numRows)
+						{
+							continue;
+						}
+
+						uint64_t line = 0;
+						for (int i = 0; i < winLength; ++i)
+						{
+							line |= getCellBit(column + direction[0] * i, row + direction[1] * i, numRows);
+						}
+						lines.push_back(line);
+					}
+				}
+			}
+
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				const uint64_t columnBits = numRows == 64 ? ~uint64_t{0} : (uint64_t{1} << numRows) - 1;
+				columnMasks.push_back(columnBits << (column * numRows));
+			}
+		}
+
+		Knowledge KnowledgeEvaluator::evaluate(const FourAcross& game) const
+		{
+			if (game.getNumPlayers() != 2 || game.getNumColumns() != numColumns ||
+				game.getNumRows() != numRows || game.getWinLength() != winLength)
+			{
+				throw std::invalid_argument("KnowledgeEvaluator::evaluate: game doesn't match the evaluator");
+			}
+
+			Knowledge knowledge{};
+			knowledge.bestMove = Solver::noMove;
+			if (game.hasWinner() || game.boardFull())
+			{
+				knowledge.outcome = game.hasWinner() ? Knowledge::Outcome::loss : Knowledge::Outcome::draw;
+				return knowledge;
+			}
+
+			const Board& board = game.getBoard();
+			const uint8_t player = game.getCurrentPlayer();
+			uint64_t pieces = 0;
+			uint64_t occupied = 0;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				for (uint8_t row = 0; row < board.getColumnHeightUnchecked(column); ++row)
+				{
+					const uint64_t cell = getCellBit(column, row, numRows);
+					occupied |= cell;
+					if (board.getDiskOwnerAtUnchecked(column, row) == player)
+					{
+						pieces |= cell;
+					}
+				}
+			}
+			const uint64_t otherPieces = occupied & ~pieces;
+
+			uint64_t playable = 0;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				playable |= getPlayableCell(column, occupied);
+			}
+
+			knowledge.threats[0] = getThreats(pieces, occupied);
+			knowledge.threats[1] = getThreats(otherPieces, occupied);
+			const uint64_t winningCells = knowledge.threats[0] & playable;
+			const uint64_t losingCells = knowledge.threats[1] & playable;
+
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				const uint64_t cell = getPlayableCell(column, occupied);
+				if ((cell & winningCells) != 0)
+				{
+					knowledge.outcome = Knowledge::Outcome::win;
+					knowledge.bestMove = column;
+					knowledge.allowedMoves = uint64_t{1} << column;
+					return knowledge;
+				}
+
+				// a move is allowed if it blocks every playable threat and doesn't open a threat above
+				const bool blocksThreats = (losingCells & ~cell) == 0;
+				const bool opensThreat = ((cell << 1) & columnMasks[column] & knowledge.threats[1]) != 0;
+				if (cell != 0 && blocksThreats && !opensThreat)
+				{
+					knowledge.allowedMoves |= uint64_t{1} << column;
+				}
+			}
+
+			if (knowledge.allowedMoves == 0)
+			{
+				knowledge.outcome = Knowledge::Outcome::loss;
+				return knowledge;
+			}
+			if (hasOneBit(knowledge.allowedMoves))
+			{
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					if (knowledge.allowedMoves == uint64_t{1} << column)
+					{
+						knowledge.bestMove = column;
+					}
+				}
+			}
+
+			// the other player follows up: at best a draw for the player to move
+			const bool isAtMostDraw = canFollowUp(otherPieces, occupied);
+
+			// or after some move, the player to move follows up
+			bool isAtLeastDraw = false;
+			for (uint8_t column = 0; column < numColumns && !isAtLeastDraw; ++column)
+			{
+				if ((knowledge.allowedMoves & (uint64_t{1} << column)) == 0)
+				{
+					continue;
+				}
+				const uint64_t cell = getPlayableCell(column, occupied);
+				if (canFollowUp(pieces | cell, occupied | cell))
+				{
+					isAtLeastDraw = true;
+					knowledge.bestMove = column;
+				}
+			}
+
+			knowledge.outcome =
+				isAtMostDraw && isAtLeastDraw ? Knowledge::Outcome::draw :
+				isAtLeastDraw ? Knowledge::Outcome::atLeastDraw :
+				isAtMostDraw ? Knowledge::Outcome::atMostDraw :
+				Knowledge::Outcome::unknown;
+			return knowledge;
+		}
+
+		bool KnowledgeEvaluator::canFollowUp(uint64_t follower, uint64_t occupied) const noexcept
+		{
+			// the follower gets the upper cell of each stacked pair; columns with an odd number of
+			// empty cells leave their playable cell for a baseinverse
+			uint64_t followerCells = 0;
+			uint8_t oddColumns[maxColumns];
+			size_t numOddColumns = 0;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				const uint8_t height = getHeight(column, occupied);
+				uint8_t firstPaired = height;
+				if ((numRows - height) % 2 == 1)
+				{
+					oddColumns[numOddColumns++] = column;
+					++firstPaired;
+				}
+				for (uint8_t row = firstPaired + 1; row < numRows; row += 2)
+				{
+					followerCells |= getCellBit(column, row, numRows);
+				}
+			}
+			if (numOddColumns % 2 == 1)
+			{
+				return false;
+			}
+
+			// lines the other player could still complete
+			const uint64_t claimed = follower | followerCells;
+			uint64_t openLines[maxLines];
+			size_t numOpenLines = 0;
+			for (auto line : lines)
+			{
+				if ((line & claimed) == 0)
+				{
+					openLines[numOpenLines++] = line;
+				}
+			}
+
+			uint64_t pairs[maxColumns / 2];
+			return pairColumns(oddColumns, numOddColumns, pairs, 0, openLines, numOpenLines, occupied);
+		}
+
+		bool KnowledgeEvaluator::pairColumns(const uint8_t* oddColumns, size_t numOddColumns, uint64_t* pairs, size_t numPairs,
+			const uint64_t* openLines, size_t numOpenLines, uint64_t occupied) const noexcept
+		{
+			if (numOddColumns == 0)
+			{
+				for (size_t i = 0; i < numOpenLines; ++i)
+				{
+					bool isRefuted = false;
+					for (size_t pair = 0; pair < numPairs && !isRefuted; ++pair)
+					{
+						isRefuted = (openLines[i] & pairs[pair]) == pairs[pair];
+					}
+					if (!isRefuted)
+					{
+						return false;
+					}
+				}
+				return true;
+			}
+
+			// pair the first column with each of the others in turn
+			uint8_t remaining[maxColumns];
+			for (size_t partner = 1; partner < numOddColumns; ++partner)
+			{
+				size_t numRemaining = 0;
+				for (size_t i = 1; i < numOddColumns; ++i)
+				{
+					if (i != partner)
+					{
+						remaining[numRemaining++] = oddColumns[i];
+					}
+				}
+				pairs[numPairs] = getPlayableCell(oddColumns[0], occupied) | getPlayableCell(oddColumns[partner], occupied);
+				if (pairColumns(remaining, numRemaining, pairs, numPairs + 1, openLines, numOpenLines, occupied))
+				{
+					return true;
+				}
+			}
+			return false;
+		}
+
+		uint64_t KnowledgeEvaluator::getThreats(uint64_t pieces, uint64_t occupied) const noexcept
+		{
+			uint64_t threats = 0;
+			for (auto line : lines)
+			{
+				const uint64_t missing = line & ~pieces;
+				if (hasOneBit(missing) && (missing & occupied) == 0)
+				{
+					threats |= missing;
+				}
+			}
+			return threats;
+		}
+
+		uint64_t KnowledgeEvaluator::getPlayableCell(uint8_t column, uint64_t occupied) const noexcept
+		{
+			const uint8_t height = getHeight(column, occupied);
+			return height < numRows ? getCellBit(column, height, numRows) : 0;
+		}
+
+		uint8_t KnowledgeEvaluator::getHeight(uint8_t column, uint64_t occupied) const noexcept
+		{
+			return static_cast<uint8_t>(std::bitset<64>{occupied & columnMasks[column]}.count());
+		}
+	}
+}
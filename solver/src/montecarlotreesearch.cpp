@@ -0,0 +1,301 @@
+#include "four-across/solver/montecarlotreesearch.hpp"
+
+#include "four-across/solver/solver.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr double MonteCarloTreeSearch::explorationWeight;
+		constexpr size_t MonteCarloTreeSearch::defaultArenaBytes;
+
+		namespace
+		{
+			constexpr uint32_t noNode{std::numeric_limits<uint32_t>::max()};
+
+			// Players are numbered from 1, and the one before the first is the last.
+			uint8_t getPreviousPlayer(uint8_t player, uint8_t numPlayers) noexcept
+			{
+				return player == 1 ? numPlayers : player - 1;
+			}
+		}
+
+		MonteCarloTreeSearch::MonteCarloTreeSearch(size_t arenaBytes, unsigned numThreads, uint32_t seed) :
+			arenaSize{std::max<size_t>(std::min<size_t>(arenaBytes / sizeof(Node), noNode - 1), 1)},
+			numPlayers{FourAcross::minNumPlayers},
+			nextFree{0},
+			isArenaFull{false},
+			numIterations{0},
+			isStopped{false},
+			maxIterations{0},
+			hasDeadline{false}
+		{
+			nodes.reset(new Node[arenaSize]);
+			workers.resize(std::max(numThreads, 1u));
+			for (size_t i = 0; i < workers.size(); ++i)
+			{
+				workers[i].engine.seed(seed + static_cast<uint32_t>(i));
+			}
+		}
+
+		MonteCarloResult MonteCarloTreeSearch::search(const FourAcross& game, const MonteCarloLimits& limits)
+		{
+			if (limits.seconds <= 0 && limits.maxIterations == 0)
+			{
+				throw std::invalid_argument("MonteCarloTreeSearch::search: the search needs a time or iteration limit");
+			}
+
+			const auto startTime = std::chrono::steady_clock::now();
+			hasDeadline = limits.seconds > 0;
+			if (hasDeadline)
+			{
+				deadline = startTime + std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+					std::chrono::duration<double>{limits.seconds});
+			}
+			maxIterations = limits.maxIterations;
+			numIterations.store(0, std::memory_order_relaxed);
+			isStopped.store(false, std::memory_order_relaxed);
+			isArenaFull.store(false, std::memory_order_relaxed);
+			numPlayers = game.getNumPlayers();
+
+			const uint8_t numColumns = game.getNumColumns();
+			columnOrder.resize(numColumns);
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				columnOrder[column] = column;
+			}
+			std::stable_sort(columnOrder.begin(), columnOrder.end(), [numColumns](uint8_t lhs, uint8_t rhs)
+				{
+					return std::abs(2 * lhs - (numColumns - 1)) < std::abs(2 * rhs - (numColumns - 1));
+				});
+
+			// the tree of the last search is dropped, starting the arena over
+			Node& root = nodes[0];
+			root.reward.store(0, std::memory_order_relaxed);
+			root.visits.store(0, std::memory_order_relaxed);
+			root.state.store(unexpanded, std::memory_order_relaxed);
+			root.numChildren = 0;
+			root.move = Solver::noMove;
+			nextFree.store(1, std::memory_order_relaxed);
+
+			MonteCarloResult result{};
+			result.bestMove = Solver::noMove;
+			if (!game.hasWinner() && !game.boardFull())
+			{
+				const size_t maxMoves = game.getNumColumns() * game.getNumRows() + 1;
+				for (auto& worker : workers)
+				{
+					worker.game = game;
+					worker.path.reserve(maxMoves);
+					worker.movers.reserve(maxMoves);
+					worker.numIterations = 0;
+				}
+
+				std::vector<std::thread> helpers;
+				for (size_t i = 1; i < workers.size(); ++i)
+				{
+					helpers.emplace_back(&MonteCarloTreeSearch::runWorker, this, std::ref(workers[i]));
+				}
+				runWorker(workers.front());
+				for (auto& helper : helpers)
+				{
+					helper.join();
+				}
+
+				if (root.state.load(std::memory_order_acquire) == expanded)
+				{
+					for (uint32_t child = root.firstChild; child < root.firstChild + root.numChildren; ++child)
+					{
+						const uint32_t visits = nodes[child].visits.load(std::memory_order_relaxed);
+						if (result.bestMove == Solver::noMove || visits > result.bestMoveVisits)
+						{
+							result.bestMove = nodes[child].move;
+							result.bestMoveVisits = visits;
+							result.value = visits > 0 ?
+								static_cast<double>(nodes[child].reward.load(std::memory_order_relaxed)) / visits / numPlayers : 0;
+						}
+					}
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			for (const auto& worker : workers)
+			{
+				result.numIterations += worker.numIterations;
+			}
+			result.numNodes = std::min<uint64_t>(nextFree.load(std::memory_order_relaxed), arenaSize);
+			result.isArenaFull = isArenaFull.load(std::memory_order_relaxed);
+			result.seconds = elapsed.count();
+			result.iterationsPerSecond = result.seconds > 0 ? result.numIterations / result.seconds : 0;
+			return result;
+		}
+
+		void MonteCarloTreeSearch::runWorker(Worker& worker)
+		{
+			// every thread runs at least one iteration, so the root always has children
+			do
+			{
+				runIteration(worker);
+				++worker.numIterations;
+			} while (!shouldStop());
+			isStopped.store(true, std::memory_order_relaxed);
+		}
+
+		void MonteCarloTreeSearch::runIteration(Worker& worker)
+		{
+			FourAcross& game = worker.game;
+			worker.path.clear();
+			worker.movers.clear();
+
+			uint32_t node = 0;
+			worker.path.push_back(node);
+			worker.movers.push_back(getPreviousPlayer(game.getCurrentPlayer(), numPlayers));
+			nodes[node].visits.fetch_add(1, std::memory_order_relaxed);
+
+			// go down to a position without children, adding them if no other thread is
+			uint32_t numMoves = 0;
+			while (!game.hasWinner() && !game.boardFull())
+			{
+				uint8_t state = nodes[node].state.load(std::memory_order_acquire);
+				if (state == unexpanded && !isArenaFull.load(std::memory_order_relaxed) &&
+					nodes[node].state.compare_exchange_strong(state, expanding, std::memory_order_relaxed))
+				{
+					state = expand(node, game) ? expanded : unexpanded;
+				}
+				if (state != expanded)
+				{
+					break;
+				}
+
+				node = select(node);
+				worker.movers.push_back(game.getCurrentPlayer());
+				worker.path.push_back(node);
+				nodes[node].visits.fetch_add(1, std::memory_order_relaxed);
+				game.makeMove(nodes[node].move);
+				++numMoves;
+			}
+
+			numMoves += playOut(worker);
+			const uint8_t winner = game.getWinner();
+			for (size_t i = 0; i < worker.path.size(); ++i)
+			{
+				const uint64_t reward = winner == worker.movers[i] ? numPlayers : winner == FourAcross::noWinner ? 1 : 0;
+				if (reward != 0)
+				{
+					nodes[worker.path[i]].reward.fetch_add(reward, std::memory_order_relaxed);
+				}
+			}
+
+			for (; numMoves > 0; --numMoves)
+			{
+				game.unmakeMove();
+			}
+		}
+
+		bool MonteCarloTreeSearch::expand(uint32_t node, const FourAcross& game) noexcept
+		{
+			const Board& board = game.getBoard();
+			uint8_t numChildren = 0;
+			for (auto column : columnOrder)
+			{
+				numChildren += board.getColumnHeightUnchecked(column) < board.getNumRows();
+			}
+
+			const uint64_t firstChild = nextFree.fetch_add(numChildren, std::memory_order_relaxed);
+			if (firstChild + numChildren > arenaSize)
+			{
+				isArenaFull.store(true, std::memory_order_relaxed);
+				nodes[node].state.store(unexpanded, std::memory_order_relaxed);
+				return false;
+			}
+
+			uint32_t child = static_cast<uint32_t>(firstChild);
+			for (auto column : columnOrder)
+			{
+				if (board.getColumnHeightUnchecked(column) == board.getNumRows())
+				{
+					continue;
+				}
+				Node& added = nodes[child++];
+				added.reward.store(0, std::memory_order_relaxed);
+				added.visits.store(0, std::memory_order_relaxed);
+				added.state.store(unexpanded, std::memory_order_relaxed);
+				added.numChildren = 0;
+				added.move = column;
+			}
+
+			// publishes the children to threads that see the node expanded
+			nodes[node].firstChild = static_cast<uint32_t>(firstChild);
+			nodes[node].numChildren = numChildren;
+			nodes[node].state.store(expanded, std::memory_order_release);
+			return true;
+		}
+
+		uint32_t MonteCarloTreeSearch::select(uint32_t node) const noexcept
+		{
+			const Node& parent = nodes[node];
+			const double logVisits = std::log(static_cast<double>(std::max(parent.visits.load(std::memory_order_relaxed), 1u)));
+			uint32_t best = parent.firstChild;
+			double bestValue = -1;
+			for (uint32_t child = parent.firstChild; child < parent.firstChild + parent.numChildren; ++child)
+			{
+				// moves no thread has tried yet come first, center columns before edge ones
+				const uint32_t visits = nodes[child].visits.load(std::memory_order_relaxed);
+				if (visits == 0)
+				{
+					return child;
+				}
+
+				const double meanReward = static_cast<double>(nodes[child].reward.load(std::memory_order_relaxed)) / visits / numPlayers;
+				const double value = meanReward + explorationWeight * std::sqrt(logVisits / visits);
+				if (value > bestValue)
+				{
+					bestValue = value;
+					best = child;
+				}
+			}
+			return best;
+		}
+
+		uint32_t MonteCarloTreeSearch::playOut(Worker& worker) noexcept
+		{
+			FourAcross& game = worker.game;
+			const Board& board = game.getBoard();
+			const uint8_t numColumns = board.getNumColumns();
+			const uint8_t numRows = board.getNumRows();
+			uint32_t numMoves = 0;
+			while (!game.hasWinner() && !game.boardFull())
+			{
+				// a random column, or the next one that isn't full
+				uint8_t column = static_cast<uint8_t>(worker.engine() % numColumns);
+				while (board.getColumnHeightUnchecked(column) == numRows)
+				{
+					column = column + 1 == numColumns ? 0 : column + 1;
+				}
+				game.makeMove(column);
+				++numMoves;
+			}
+			return numMoves;
+		}
+
+		bool MonteCarloTreeSearch::shouldStop() noexcept
+		{
+			if (isStopped.load(std::memory_order_relaxed))
+			{
+				return true;
+			}
+			if (maxIterations != 0 && numIterations.fetch_add(1, std::memory_order_relaxed) + 1 >= maxIterations)
+			{
+				return true;
+			}
+			return hasDeadline && std::chrono::steady_clock::now() >= deadline;
+		}
+	}
+}
@@ -0,0 +1,222 @@
+#include "four-across/solver/openingbook.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+#if defined(__linux__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr uint8_t OpeningBook::solvedDepth;
+
+		namespace
+		{
+			constexpr char bookMagic[8] = {'F', 'A', 'B', 'O', 'O', 'K', '2', '\0'};
+		}
+
+		struct OpeningBook::Header
+		{
+			char magic[8];
+			uint8_t numColumns;
+			uint8_t numRows;
+			uint8_t winLength;
+			uint8_t maxPly;
+			uint32_t reserved;
+			uint64_t numRecords;
+		};
+
+		// The key is split in halves so records pack into 12 bytes.
+		struct OpeningBook::Record
+		{
+			uint64_t getKey() const noexcept
+			{
+				return (static_cast<uint64_t>(keyHigh) << 32) | keyLow;
+			}
+
+			uint32_t keyLow;
+			uint32_t keyHigh;
+			int16_t score;
+			uint8_t bestMove;
+			uint8_t depth;
+		};
+
+		OpeningBook::OpeningBook(const std::string& path) :
+			header{nullptr},
+			records{nullptr},
+			numRecords{0},
+			memory{nullptr},
+			memorySize{0},
+			isMapped{false}
+		{
+			static_assert(sizeof(Header) == 24, "book headers have a fixed size");
+			static_assert(sizeof(Record) == 12, "book records have a fixed size");
+
+#if defined(__linux__)
+			const int file = open(path.c_str(), O_RDONLY);
+			if (file < 0)
+			{
+				throw std::runtime_error("OpeningBook: can't open " + path);
+			}
+			struct stat status;
+			if (fstat(file, &status) == 0 && status.st_size > 0)
+			{
+				memorySize = static_cast<size_t>(status.st_size);
+				memory = mmap(nullptr, memorySize, PROT_READ, MAP_SHARED, file, 0);
+				isMapped = memory != MAP_FAILED;
+			}
+			close(file);
+			if (!isMapped)
+			{
+				memory = nullptr;
+				memorySize = 0;
+			}
+#endif
+			if (!isMapped)
+			{
+				std::ifstream file{path, std::ios::binary};
+				if (!file)
+				{
+					throw std::runtime_error("OpeningBook: can't open " + path);
+				}
+				buffer.assign(std::istreambuf_iterator<char>{file}, std::istreambuf_iterator<char>{});
+				memory = buffer.data();
+				memorySize = buffer.size();
+			}
+
+			header = static_cast<const Header*>(memory);
+			const bool isBook = memorySize >= sizeof(Header) &&
+				std::memcmp(header->magic, bookMagic, sizeof(bookMagic)) == 0 &&
+				(memorySize - sizeof(Header)) / sizeof(Record) == header->numRecords &&
+				(memorySize - sizeof(Header)) % sizeof(Record) == 0;
+			if (!isBook)
+			{
+#if defined(__linux__)
+				if (isMapped)
+				{
+					munmap(memory, memorySize);
+				}
+#endif
+				throw std::runtime_error("OpeningBook: " + path + " isn't an opening book");
+			}
+			records = reinterpret_cast<const Record*>(static_cast<const char*>(memory) + sizeof(Header));
+			numRecords = static_cast<size_t>(header->numRecords);
+		}
+
+		OpeningBook::~OpeningBook()
+		{
+#if defined(__linux__)
+			if (isMapped)
+			{
+				munmap(memory, memorySize);
+			}
+#endif
+		}
+
+		bool OpeningBook::probe(const FourAcross& game, Entry& entry) const noexcept
+		{
+			if (game.getNumColumns() != header->numColumns || game.getNumRows() != header->numRows ||
+				game.getWinLength() != header->winLength || game.getNumPlayers() != 2 ||
+				game.getNumTurns() > header->maxPly)
+			{
+				return false;
+			}
+			const zobrist::CanonicalKey key = game.getCanonicalKey();
+			if (!probe(key.key, entry))
+			{
+				return false;
+			}
+			if (key.isMirrored && entry.bestMove < game.getNumColumns())
+			{
+				entry.bestMove = game.getBoard().getMirroredColumn(entry.bestMove);
+			}
+			return true;
+		}
+
+		bool OpeningBook::probe(uint64_t key, Entry& entry) const noexcept
+		{
+			const Record* const end = records + numRecords;
+			const Record* const found = std::lower_bound(records, end, key, [](const Record& record, uint64_t key)
+				{
+					return record.getKey() < key;
+				});
+			if (found == end || found->getKey() != key)
+			{
+				return false;
+			}
+			entry = {found->score, found->bestMove, found->depth};
+			return true;
+		}
+
+		uint8_t OpeningBook::getNumColumns() const noexcept
+		{
+			return header->numColumns;
+		}
+
+		uint8_t OpeningBook::getNumRows() const noexcept
+		{
+			return header->numRows;
+		}
+
+		uint8_t OpeningBook::getWinLength() const noexcept
+		{
+			return header->winLength;
+		}
+
+		uint8_t OpeningBook::getMaxPly() const noexcept
+		{
+			return header->maxPly;
+		}
+
+		void OpeningBook::write(const std::string& path, uint8_t numColumns, uint8_t numRows, uint8_t winLength,
+			uint8_t maxPly, std::vector<Position> positions)
+		{
+			std::sort(positions.begin(), positions.end(), [](const Position& lhs, const Position& rhs)
+				{
+					return lhs.key < rhs.key;
+				});
+			positions.erase(std::unique(positions.begin(), positions.end(), [](const Position& lhs, const Position& rhs)
+				{
+					return lhs.key == rhs.key;
+				}), positions.end());
+
+			Header header{};
+			std::memcpy(header.magic, bookMagic, sizeof(bookMagic));
+			header.numColumns = numColumns;
+			header.numRows = numRows;
+			header.winLength = winLength;
+			header.maxPly = maxPly;
+			header.numRecords = positions.size();
+
+			std::vector<Record> records;
+			records.reserve(positions.size());
+			for (const auto& position : positions)
+			{
+				records.push_back({
+					static_cast<uint32_t>(position.key),
+					static_cast<uint32_t>(position.key >> 32),
+					position.entry.score,
+					position.entry.bestMove,
+					position.entry.depth});
+			}
+
+			std::ofstream file{path, std::ios::binary | std::ios::trunc};
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(records.data()), records.size() * sizeof(Record));
+			file.flush();
+			if (!file)
+			{
+				throw std::runtime_error("OpeningBook::write: can't write " + path);
+			}
+		}
+	}
+}
@@ -0,0 +1,354 @@
+#include "four-across/solver/proofnumbersearch.hpp"
+
+#include "four-across/solver/solver.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <limits>
+#include <stdexcept>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr size_t ProofNumberSearch::defaultArenaBytes;
+
+		namespace
+		{
+			constexpr uint32_t infinity{std::numeric_limits<uint32_t>::max()};
+			constexpr uint32_t noNode{std::numeric_limits<uint32_t>::max()};
+
+			uint32_t addProofNumbers(uint32_t lhs, uint32_t rhs) noexcept
+			{
+				return lhs >= infinity - rhs ? infinity : lhs + rhs;
+			}
+		}
+
+		ProofNumberSearch::ProofNumberSearch(size_t arenaBytes) :
+			nodes(std::max<size_t>(std::min<size_t>(arenaBytes / sizeof(Node), noNode - 1), 1)),
+			root{noNode},
+			firstFree{noNode},
+			numFree{0},
+			numNodes{0},
+			numCollections{0}
+		{
+		}
+
+		ProofResult ProofNumberSearch::solve(const FourAcross& position, uint64_t maxNodes)
+		{
+			if (position.getNumPlayers() != 2)
+			{
+				throw std::invalid_argument("ProofNumberSearch::solve: only two player games can be solved");
+			}
+
+			const auto startTime = std::chrono::steady_clock::now();
+			game = position;
+			numNodes = 0;
+			numCollections = 0;
+
+			const uint8_t numColumns = game.getNumColumns();
+			columnOrder.resize(numColumns);
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				columnOrder[column] = column;
+			}
+			std::stable_sort(columnOrder.begin(), columnOrder.end(), [numColumns](uint8_t lhs, uint8_t rhs)
+				{
+					return std::abs(2 * lhs - (numColumns - 1)) < std::abs(2 * rhs - (numColumns - 1));
+				});
+
+			ProofResult result{};
+			result.outcome = ProofResult::Outcome::unknown;
+			result.bestMove = Solver::noMove;
+
+			// players are numbered 1 and 2
+			const uint8_t player = game.getCurrentPlayer();
+			const Proof winProof = prove(player, maxNodes);
+			if (winProof == Proof::proven)
+			{
+				result.outcome = ProofResult::Outcome::win;
+				result.proofSize = nodes[root].proofSize;
+
+				uint64_t smallestProof = std::numeric_limits<uint64_t>::max();
+				for (uint32_t child = nodes[root].firstChild; child != noNode; child = nodes[child].nextSibling)
+				{
+					if (nodes[child].proof == 0 && nodes[child].proofSize < smallestProof)
+					{
+						smallestProof = nodes[child].proofSize;
+						result.bestMove = nodes[child].move;
+					}
+				}
+			}
+			else if (winProof == Proof::disproven)
+			{
+				const uint64_t disproofSize = nodes[root].proofSize;
+				const Proof lossProof = prove(3 - player, maxNodes);
+				if (lossProof == Proof::proven)
+				{
+					result.outcome = ProofResult::Outcome::loss;
+					result.proofSize = nodes[root].proofSize;
+				}
+				else if (lossProof == Proof::disproven)
+				{
+					result.outcome = ProofResult::Outcome::draw;
+					result.proofSize = disproofSize + nodes[root].proofSize;
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			result.numNodes = numNodes;
+			result.numCollections = numCollections;
+			result.seconds = elapsed.count();
+			result.nodesPerSecond = result.seconds > 0 ? numNodes / result.seconds : 0;
+			return result;
+		}
+
+		ProofNumberSearch::Proof ProofNumberSearch::prove(uint8_t attacker, uint64_t maxNodes)
+		{
+			// start from an empty arena
+			for (uint32_t node = 0; node < nodes.size(); ++node)
+			{
+				nodes[node].nextSibling = node + 1 < nodes.size() ? node + 1 : noNode;
+			}
+			firstFree = 0;
+			numFree = nodes.size();
+
+			root = allocate();
+			nodes[root].parent = noNode;
+			nodes[root].firstChild = noNode;
+			nodes[root].nextSibling = noNode;
+			nodes[root].move = Solver::noMove;
+			evaluate(nodes[root], attacker);
+			++numNodes;
+
+			// the search continues from the lowest node whose numbers didn't change, since the most
+			// proving node is still under it
+			uint32_t node = root;
+			while (!isSolved(nodes[root]))
+			{
+				if (maxNodes != 0 && numNodes >= maxNodes)
+				{
+					for (; node != root; node = nodes[node].parent)
+					{
+						game.unmakeMove();
+					}
+					return Proof::unknown;
+				}
+
+				// go down to the most proving node: the child with the smallest proof number where the
+				// attacker moves, and with the smallest disproof number where the defender moves
+				while (nodes[node].firstChild != noNode)
+				{
+					const bool isOrNode = game.getCurrentPlayer() == attacker;
+					uint32_t best = nodes[node].firstChild;
+					for (uint32_t child = nodes[best].nextSibling; child != noNode; child = nodes[child].nextSibling)
+					{
+						const bool isBetter = isOrNode ?
+							nodes[child].proof < nodes[best].proof :
+							nodes[child].disproof < nodes[best].disproof;
+						if (isBetter)
+						{
+							best = child;
+						}
+					}
+					node = best;
+					game.makeMove(nodes[node].move);
+				}
+
+				if (numFree < game.getNumColumns())
+				{
+					collectGarbage();
+				}
+				if (numFree < game.getNumColumns())
+				{
+					// out of memory with nothing left to collect
+					for (; node != root; node = nodes[node].parent)
+					{
+						game.unmakeMove();
+					}
+					return Proof::unknown;
+				}
+
+				expand(node, attacker);
+				for (;; node = nodes[node].parent)
+				{
+					const uint32_t proof = nodes[node].proof;
+					const uint32_t disproof = nodes[node].disproof;
+					update(node, game.getCurrentPlayer() == attacker);
+					const bool isUnchanged = nodes[node].proof == proof && nodes[node].disproof == disproof;
+					if (node == root || (isUnchanged && !isSolved(nodes[node])))
+					{
+						break;
+					}
+					game.unmakeMove();
+				}
+			}
+
+			return nodes[root].proof == 0 ? Proof::proven : Proof::disproven;
+		}
+
+		void ProofNumberSearch::expand(uint32_t node, uint8_t attacker)
+		{
+			const bool isOrNode = game.getCurrentPlayer() == attacker;
+			const Board& board = game.getBoard();
+			uint32_t* link = &nodes[node].firstChild;
+			for (auto column : columnOrder)
+			{
+				if (board.getColumnHeightUnchecked(column) == board.getNumRows())
+				{
+					continue;
+				}
+
+				const uint32_t child = allocate();
+				Node& added = nodes[child];
+				added.parent = node;
+				added.firstChild = noNode;
+				added.nextSibling = noNode;
+				added.move = column;
+				*link = child;
+				link = &added.nextSibling;
+
+				game.makeMove(column);
+				evaluate(added, attacker);
+				game.unmakeMove();
+				++numNodes;
+
+				// a child that settles the node makes the rest unnecessary
+				if ((isOrNode && added.proof == 0) || (!isOrNode && added.disproof == 0))
+				{
+					break;
+				}
+			}
+		}
+
+		void ProofNumberSearch::update(uint32_t node, bool isOrNode) noexcept
+		{
+			uint32_t smallestProof = infinity;
+			uint32_t smallestDisproof = infinity;
+			uint32_t proofSum = 0;
+			uint32_t disproofSum = 0;
+			uint64_t smallestProofSize = std::numeric_limits<uint64_t>::max();
+			uint64_t proofSizeSum = 0;
+			for (uint32_t child = nodes[node].firstChild; child != noNode; child = nodes[child].nextSibling)
+			{
+				const Node& searched = nodes[child];
+				smallestProof = std::min(smallestProof, searched.proof);
+				smallestDisproof = std::min(smallestDisproof, searched.disproof);
+				proofSum = addProofNumbers(proofSum, searched.proof);
+				disproofSum = addProofNumbers(disproofSum, searched.disproof);
+
+				// the attacker needs one proven move where they move and every move where they don't,
+				// and the other way around for disproofs
+				const bool isSettling = isOrNode ? searched.proof == 0 : searched.disproof == 0;
+				if (isSettling)
+				{
+					smallestProofSize = std::min(smallestProofSize, searched.proofSize);
+				}
+				proofSizeSum += searched.proofSize;
+			}
+
+			Node& updated = nodes[node];
+			updated.proof = isOrNode ? smallestProof : proofSum;
+			updated.disproof = isOrNode ? disproofSum : smallestDisproof;
+			if (isSolved(updated))
+			{
+				const bool isSettledByOne = isOrNode == (updated.proof == 0);
+				updated.proofSize = 1 + (isSettledByOne ? smallestProofSize : proofSizeSum);
+			}
+		}
+
+		void ProofNumberSearch::evaluate(Node& node, uint8_t attacker) const noexcept
+		{
+			node.proofSize = 1;
+			if (game.hasWinner())
+			{
+				const bool isAttackerWin = game.getWinner() == attacker;
+				node.proof = isAttackerWin ? 0 : infinity;
+				node.disproof = isAttackerWin ? infinity : 0;
+				return;
+			}
+			if (game.boardFull())
+			{
+				node.proof = infinity;
+				node.disproof = 0;
+				return;
+			}
+
+			// positions with more moves take more work to prove for the player choosing among them
+			const Board& board = game.getBoard();
+			uint32_t numMoves = 0;
+			for (uint8_t column = 0; column < board.getNumColumns(); ++column)
+			{
+				numMoves += board.getColumnHeightUnchecked(column) < board.getNumRows();
+			}
+			const bool isOrNode = game.getCurrentPlayer() == attacker;
+			node.proof = isOrNode ? 1 : numMoves;
+			node.disproof = isOrNode ? numMoves : 1;
+		}
+
+		uint32_t ProofNumberSearch::allocate() noexcept
+		{
+			const uint32_t node = firstFree;
+			firstFree = nodes[node].nextSibling;
+			--numFree;
+			return node;
+		}
+
+		void ProofNumberSearch::freeChildren(uint32_t node) noexcept
+		{
+			pending.clear();
+			pending.push_back(nodes[node].firstChild);
+			nodes[node].firstChild = noNode;
+			while (!pending.empty())
+			{
+				const uint32_t sibling = pending.back();
+				pending.pop_back();
+				for (uint32_t freed = sibling; freed != noNode;)
+				{
+					if (nodes[freed].firstChild != noNode)
+					{
+						pending.push_back(nodes[freed].firstChild);
+					}
+					const uint32_t next = nodes[freed].nextSibling;
+					nodes[freed].nextSibling = firstFree;
+					firstFree = freed;
+					++numFree;
+					freed = next;
+				}
+			}
+		}
+
+		void ProofNumberSearch::collectGarbage() noexcept
+		{
+			++numCollections;
+
+			// solved subtrees keep their result in their top node, so everything under it can go
+			std::vector<uint32_t> unsolved{root};
+			while (!unsolved.empty())
+			{
+				const uint32_t node = unsolved.back();
+				unsolved.pop_back();
+				for (uint32_t child = nodes[node].firstChild; child != noNode; child = nodes[child].nextSibling)
+				{
+					if (isSolved(nodes[child]))
+					{
+						if (nodes[child].firstChild != noNode)
+						{
+							freeChildren(child);
+						}
+					}
+					else
+					{
+						unsolved.push_back(child);
+					}
+				}
+			}
+		}
+
+		bool ProofNumberSearch::isSolved(const Node& node) const noexcept
+		{
+			return node.proof == 0 || node.disproof == 0;
+		}
+	}
+}
@@ -0,0 +1,401 @@
+#include "four-across/solver/solver.hpp"
+
+#include "four-across/solver/openingbook.hpp"
+#include "four-across/solver/tablebase.hpp"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <stdexcept>
+#include <thread>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr int16_t Solver::winScore;
+		constexpr uint8_t Solver::maxDepth;
+		constexpr uint8_t Solver::noMove;
+		constexpr size_t Solver::defaultTableBytes;
+
+		namespace
+		{
+			// Table depth of positions whose value doesn't depend on the depth limit.
+			constexpr uint8_t solvedDepth{255};
+
+			constexpr int infiniteScore{Solver::winScore + 1};
+
+			// Workers add their node counts to the shared count in batches, to keep it out of their caches.
+			constexpr uint64_t nodeBatchSize{1024};
+
+			int getTablebaseScore(const Tablebase::Entry& entry) noexcept
+			{
+				switch (entry.outcome)
+				{
+				case Tablebase::Outcome::win:
+					return Solver::winScore - entry.distance;
+				case Tablebase::Outcome::loss:
+					return -(Solver::winScore - entry.distance);
+				default:
+					return 0;
+				}
+			}
+		}
+
+		Solver::Solver(size_t tableBytes, unsigned numThreads) :
+			table{tableBytes},
+			workers(std::max(numThreads, 1u)),
+			book{nullptr},
+			tablebase{nullptr},
+			tableColumns{0},
+			tableRows{0},
+			tableWinLength{0},
+			maxNodes{0},
+			sharedNodes{0},
+			isStopped{false}
+		{
+		}
+
+		SearchResult Solver::solve(const FourAcross& game, const SearchLimits& limits)
+		{
+			if (game.getNumPlayers() != 2)
+			{
+				throw std::invalid_argument("Solver::solve: only two player games can be solved");
+			}
+
+			const auto startTime = std::chrono::steady_clock::now();
+
+			const uint8_t numColumns = game.getNumColumns();
+			columnOrder.resize(numColumns);
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				columnOrder[column] = column;
+			}
+			std::stable_sort(columnOrder.begin(), columnOrder.end(), [numColumns](uint8_t lhs, uint8_t rhs)
+				{
+					return std::abs(2 * lhs - (numColumns - 1)) < std::abs(2 * rhs - (numColumns - 1));
+				});
+
+			const int emptyCells = game.getNumColumns() * game.getNumRows() - static_cast<int>(game.getNumTurns());
+			uint8_t depthLimit = static_cast<uint8_t>(std::min<int>(emptyCells, maxDepth));
+			if (limits.maxDepth != 0)
+			{
+				depthLimit = std::min(depthLimit, limits.maxDepth);
+			}
+
+			OpeningBook::Entry bookEntry;
+			if (book != nullptr && !game.hasWinner() && !game.boardFull() && book->probe(game, bookEntry) &&
+				(bookEntry.depth == OpeningBook::solvedDepth || bookEntry.depth >= depthLimit))
+			{
+				SearchResult result{};
+				result.score = bookEntry.score;
+				result.bestMove = bookEntry.bestMove;
+				result.depth = std::min(bookEntry.depth, depthLimit);
+				result.isSolved = bookEntry.depth == OpeningBook::solvedDepth;
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+				result.seconds = elapsed.count();
+				return result;
+			}
+
+			Tablebase::Entry tablebaseEntry;
+			if (tablebase != nullptr && tablebase->probe(game, tablebaseEntry))
+			{
+				SearchResult result{};
+				result.score = static_cast<int16_t>(getTablebaseScore(tablebaseEntry));
+				result.bestMove = noMove;
+				result.depth = std::min(tablebaseEntry.distance, depthLimit);
+				result.isSolved = true;
+
+				FourAcross& position = workers.front().game;
+				position = game;
+				int bestScore = -infiniteScore;
+				for (auto column : columnOrder)
+				{
+					if (position.hasWinner() || position.getBoard().getColumnHeightUnchecked(column) == position.getNumRows())
+					{
+						continue;
+					}
+					position.makeMove(column);
+					Tablebase::Entry childEntry;
+					const int score = tablebase->probe(position, childEntry) ? -getTablebaseScore(childEntry) : -infiniteScore;
+					position.unmakeMove();
+					if (score > bestScore)
+					{
+						bestScore = score;
+						result.bestMove = column;
+					}
+				}
+
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+				result.seconds = elapsed.count();
+				return result;
+			}
+
+			if (game.getNumColumns() != tableColumns || game.getNumRows() != tableRows || game.getWinLength() != tableWinLength)
+			{
+				table.clear();
+				tableColumns = game.getNumColumns();
+				tableRows = game.getNumRows();
+				tableWinLength = game.getWinLength();
+			}
+
+			maxNodes = limits.maxNodes;
+			sharedNodes.store(0, std::memory_order_relaxed);
+			isStopped.store(false, std::memory_order_relaxed);
+			table.startNewSearch();
+			for (auto& worker : workers)
+			{
+				worker.game = game;
+				worker.numNodes = 0;
+				worker.unsharedNodes = 0;
+				worker.isAborted = false;
+			}
+
+			SearchResult result{};
+			result.bestMove = noMove;
+			if (game.hasWinner() || game.boardFull())
+			{
+				result.score = static_cast<int16_t>(game.hasWinner() ? -winScore : 0);
+				result.isSolved = true;
+				depthLimit = 0;
+			}
+
+			std::vector<std::thread> helpers;
+			for (size_t i = 1; i < workers.size() && depthLimit > 1; ++i)
+			{
+				helpers.emplace_back(&Solver::runHelper, this, std::ref(workers[i]), static_cast<uint8_t>(1 + i % 2), depthLimit);
+			}
+
+			Worker& worker = workers.front();
+			for (uint8_t depth = 1; depth <= depthLimit && !result.isSolved; ++depth)
+			{
+				worker.reachedHorizon = false;
+				worker.rootBestMove = noMove;
+				const int score = negamax(worker, depth, 0, -infiniteScore, infiniteScore);
+				if (worker.isAborted)
+				{
+					// keep the last finished depth, unless there isn't one yet
+					if (result.bestMove == noMove)
+					{
+						result.bestMove = worker.rootBestMove;
+					}
+					break;
+				}
+
+				result.score = static_cast<int16_t>(score);
+				result.bestMove = worker.rootBestMove;
+				result.depth = depth;
+				// a win or loss within the depth is final, but one further away may come from a table entry
+				// of an earlier search while a quicker win is still beyond this depth
+				const bool isDecidedWithinDepth = (isWinScore(score) || isLossScore(score)) &&
+					winScore - std::abs(score) <= depth;
+				result.isSolved = !worker.reachedHorizon || isDecidedWithinDepth;
+			}
+
+			isStopped.store(true, std::memory_order_relaxed);
+			for (auto& helper : helpers)
+			{
+				helper.join();
+			}
+
+			if (result.bestMove == noMove && !game.hasWinner() && !game.boardFull())
+			{
+				// out of nodes before the first move was searched, fall back to the first legal move
+				const Board& board = game.getBoard();
+				for (auto column : columnOrder)
+				{
+					if (board.getColumnHeightUnchecked(column) < board.getNumRows())
+					{
+						result.bestMove = column;
+						break;
+					}
+				}
+			}
+
+			const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+			for (const auto& searched : workers)
+			{
+				result.numNodes += searched.numNodes;
+			}
+			result.seconds = elapsed.count();
+			result.nodesPerSecond = result.seconds > 0 ? result.numNodes / result.seconds : 0;
+			return result;
+		}
+
+		void Solver::clear() noexcept
+		{
+			table.clear();
+		}
+
+		void Solver::setOpeningBook(const OpeningBook* book) noexcept
+		{
+			this->book = book;
+		}
+
+		void Solver::setTablebase(const Tablebase* tablebase) noexcept
+		{
+			this->tablebase = tablebase;
+		}
+
+		void Solver::runHelper(Worker& worker, uint8_t firstDepth, uint8_t depthLimit)
+		{
+			for (uint8_t depth = firstDepth; depth <= depthLimit; ++depth)
+			{
+				worker.reachedHorizon = false;
+				negamax(worker, depth, 0, -infiniteScore, infiniteScore);
+				if (worker.isAborted || !worker.reachedHorizon)
+				{
+					// stopped, or solved and stored in the table for the calling thread
+					break;
+				}
+			}
+		}
+
+		bool Solver::countNode(Worker& worker) noexcept
+		{
+			++worker.numNodes;
+			if (++worker.unsharedNodes == nodeBatchSize)
+			{
+				sharedNodes.fetch_add(worker.unsharedNodes, std::memory_order_relaxed);
+				worker.unsharedNodes = 0;
+			}
+
+			const bool isOverBudget = maxNodes != 0 &&
+				sharedNodes.load(std::memory_order_relaxed) + worker.unsharedNodes > maxNodes;
+			if (isOverBudget)
+			{
+				isStopped.store(true, std::memory_order_relaxed);
+			}
+			worker.isAborted = isOverBudget || isStopped.load(std::memory_order_relaxed);
+			return !worker.isAborted;
+		}
+
+		int Solver::negamax(Worker& worker, uint8_t depth, uint8_t ply, int alpha, int beta)
+		{
+			if (!countNode(worker))
+			{
+				return 0;
+			}
+
+			FourAcross& game = worker.game;
+			if (game.hasWinner())
+			{
+				// the player who just moved won
+				return -(winScore - ply);
+			}
+
+			if (game.boardFull())
+			{
+				return 0;
+			}
+
+			if (depth == 0)
+			{
+				worker.reachedHorizon = true;
+				return 0;
+			}
+
+			// a position and its mirror share an entry, with the move stored for the canonical one
+			const Board& board = game.getBoard();
+			const zobrist::CanonicalKey key = game.getCanonicalKey();
+			const auto toTableMove = [&board, &key](uint8_t column)
+			{
+				return key.isMirrored && column != noMove ? board.getMirroredColumn(column) : column;
+			};
+
+			uint8_t tableMove = noMove;
+			TranspositionTable::Entry entry;
+			if (table.probe(key.key, entry))
+			{
+				tableMove = toTableMove(entry.bestMove);
+				if (entry.depth >= depth && ply > 0)
+				{
+					const int score = fromTableScore(entry.score, ply);
+					if (entry.bound == TranspositionTable::Bound::exact ||
+						(entry.bound == TranspositionTable::Bound::lower && score >= beta) ||
+						(entry.bound == TranspositionTable::Bound::upper && score <= alpha))
+					{
+						worker.reachedHorizon = worker.reachedHorizon || entry.depth != solvedDepth;
+						return score;
+					}
+				}
+			}
+
+			// track the horizon of this subtree alone, to know if its value can be stored as solved
+			const bool parentReachedHorizon = worker.reachedHorizon;
+			worker.reachedHorizon = false;
+
+			const int originalAlpha = alpha;
+			int bestScore = -infiniteScore;
+			uint8_t bestMove = noMove;
+			for (size_t i = 0; i <= columnOrder.size(); ++i)
+			{
+				// the table's move goes first, then the rest in column order
+				const uint8_t column = i == 0 ? tableMove : columnOrder[i - 1];
+				if (column == noMove || (i > 0 && column == tableMove) ||
+					board.getColumnHeightUnchecked(column) == board.getNumRows())
+				{
+					continue;
+				}
+
+				game.makeMove(column);
+				const int score = -negamax(worker, depth - 1, ply + 1, -beta, -alpha);
+				game.unmakeMove();
+				if (worker.isAborted)
+				{
+					return 0;
+				}
+
+				if (score > bestScore)
+				{
+					bestScore = score;
+					bestMove = column;
+					if (ply == 0)
+					{
+						worker.rootBestMove = column;
+					}
+				}
+				alpha = std::max(alpha, score);
+				if (alpha >= beta)
+				{
+					break;
+				}
+			}
+
+			const TranspositionTable::Bound bound =
+				bestScore <= originalAlpha ? TranspositionTable::Bound::upper :
+				bestScore >= beta ? TranspositionTable::Bound::lower :
+				TranspositionTable::Bound::exact;
+			table.store(key.key, {toTableScore(bestScore, ply), worker.reachedHorizon ? depth : solvedDepth, bound, toTableMove(bestMove)});
+
+			worker.reachedHorizon = worker.reachedHorizon || parentReachedHorizon;
+			return bestScore;
+		}
+
+		int16_t Solver::toTableScore(int score, uint8_t ply) noexcept
+		{
+			if (isWinScore(score))
+			{
+				return static_cast<int16_t>(score + ply);
+			}
+			if (isLossScore(score))
+			{
+				return static_cast<int16_t>(score - ply);
+			}
+			return static_cast<int16_t>(score);
+		}
+
+		int Solver::fromTableScore(int16_t score, uint8_t ply) noexcept
+		{
+			if (isWinScore(score))
+			{
+				return score - ply;
+			}
+			if (isLossScore(score))
+			{
+				return score + ply;
+			}
+			return score;
+		}
+	}
+}
@@ -0,0 +1,424 @@
+#include "four-across/solver/tablebase.hpp"
+
+#include <algorithm>
+#include <bitset>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+namespace game
+{
+	namespace solver
+	{
+		constexpr uint32_t Tablebase::maxIndices;
+
+		namespace
+		{
+			constexpr char tablebaseMagic[8] = {'F', 'A', 'T', 'B', 'A', 'S', 'E', '1'};
+
+			// Words of the reachable bitmap counted by each rank.
+			constexpr size_t blockWords{8};
+
+			// Results are stored as one byte: 0 for unreachable positions, 1 for draws, and the
+			// distance to the end times two plus 2 for losses and plus 3 for wins.
+			constexpr uint8_t unreachableValue{0};
+			constexpr uint8_t drawValue{1};
+			// Reached but not valued yet, while generating.
+			constexpr uint8_t unsolvedValue{255};
+
+			uint8_t encodeLoss(int distance) noexcept
+			{
+				return static_cast<uint8_t>(2 + 2 * distance);
+			}
+
+			uint8_t encodeWin(int distance) noexcept
+			{
+				return static_cast<uint8_t>(3 + 2 * distance);
+			}
+
+			struct Header
+			{
+				char magic[8];
+				uint8_t numColumns;
+				uint8_t numRows;
+				uint8_t winLength;
+				uint8_t reserved;
+				uint32_t numIndices;
+				uint64_t numPositions;
+			};
+
+			size_t countBits(uint64_t word) noexcept
+			{
+				return std::bitset<64>{word}.count();
+			}
+
+			// Returns true if pieces, a column-major bitboard with an empty row above every column,
+			// has a line of winLength in any direction.
+			bool hasLine(uint64_t pieces, uint8_t winLength, uint8_t numRows) noexcept
+			{
+				const unsigned shifts[] = {1u, numRows + 1u, numRows + 2u, static_cast<unsigned>(numRows)};
+				for (auto shift : shifts)
+				{
+					uint64_t lineStarts = pieces;
+					for (unsigned i = 1; i < winLength && lineStarts != 0; ++i)
+					{
+						lineStarts = shift * i < 64 ? lineStarts & (pieces >> (shift * i)) : 0;
+					}
+					if (lineStarts != 0)
+					{
+						return true;
+					}
+				}
+				return false;
+			}
+		}
+
+		Tablebase::Tablebase(uint8_t numColumns, uint8_t numRows, uint8_t winLength) :
+			numColumns{numColumns},
+			numRows{numRows},
+			winLength{winLength},
+			numIndices{0}
+		{
+			if (!isSupported(numColumns, numRows))
+			{
+				throw std::invalid_argument("Tablebase: board is too large");
+			}
+			if (winLength < FourAcross::minWinLength || winLength > numColumns)
+			{
+				throw std::invalid_argument("Tablebase: invalid win length");
+			}
+
+			numIndices = 1;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				numIndices *= (1u << (numRows + 1)) - 1;
+			}
+		}
+
+		/*
+			Each column is numbered by its state: 1 << height, with bit i set for pieces of the player
+			to move, less 1. A position's number has the columns as digits, column 0 lowest.
+		*/
+		Tablebase Tablebase::generate(uint8_t numColumns, uint8_t numRows, uint8_t winLength)
+		{
+			Tablebase tablebase{numColumns, numRows, winLength};
+
+			const uint32_t numStates = (1u << (numRows + 1)) - 1;
+			const uint8_t stride = numRows + 1;
+			std::vector<uint32_t> powers(numColumns, 1);
+			for (uint8_t column = 1; column < numColumns; ++column)
+			{
+				powers[column] = powers[column - 1] * numStates;
+			}
+
+			// height of each column state, and the state with the pieces' owners swapped
+			std::vector<uint8_t> heights(numStates + 1);
+			std::vector<uint32_t> swapped(numStates + 1);
+			for (uint32_t state = 1; state <= numStates; ++state)
+			{
+				uint8_t height = 0;
+				while (state >> (height + 1))
+				{
+					++height;
+				}
+				const uint32_t heightBit = 1u << height;
+				heights[state] = height;
+				swapped[state] = heightBit | (~state & (heightBit - 1));
+			}
+
+			std::vector<uint32_t> columns(numColumns);
+			const auto decode = [&](uint32_t index)
+			{
+				uint64_t movers = 0;
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					columns[column] = index / powers[column] % numStates + 1;
+					const uint64_t pieces = columns[column] ^ (1u << heights[columns[column]]);
+					movers |= pieces << (column * stride);
+				}
+				return movers;
+			};
+
+			// number of the position after the player to move plays in column, seen from the other player
+			const auto getChildIndex = [&](uint8_t moveColumn)
+			{
+				uint32_t index = 0;
+				for (uint8_t column = 0; column < numColumns; ++column)
+				{
+					uint32_t state = columns[column];
+					if (column == moveColumn)
+					{
+						state |= 1u << (heights[state] + 1);
+					}
+					index += (swapped[state] - 1) * powers[column];
+				}
+				return index;
+			};
+
+			std::vector<uint8_t> allValues(tablebase.numIndices, unreachableValue);
+			const uint8_t numCells = numColumns * numRows;
+			std::vector<std::vector<uint32_t>> plies(numCells + 1);
+
+			// find every position that can be played to, by ply
+			plies[0].push_back(0);
+			allValues[0] = unsolvedValue;
+			for (uint8_t ply = 0; ply < numCells; ++ply)
+			{
+				for (auto index : plies[ply])
+				{
+					const uint64_t movers = decode(index);
+					for (uint8_t column = 0; column < numColumns; ++column)
+					{
+						const uint8_t height = heights[columns[column]];
+						if (height == numRows)
+						{
+							continue;
+						}
+
+						const uint32_t child = getChildIndex(column);
+						if (allValues[child] != unreachableValue)
+						{
+							continue;
+						}
+
+						const uint64_t moved = movers | (uint64_t{1} << (column * stride + height));
+						if (hasLine(moved, winLength, numRows))
+						{
+							allValues[child] = encodeLoss(0);
+						}
+						else if (ply + 1 == numCells)
+						{
+							allValues[child] = drawValue;
+						}
+						else
+						{
+							allValues[child] = unsolvedValue;
+							plies[ply + 1].push_back(child);
+						}
+					}
+				}
+			}
+
+			// value them from the last ply back
+			for (int ply = numCells - 1; ply >= 0; --ply)
+			{
+				for (auto index : plies[ply])
+				{
+					decode(index);
+					int fastestWin = unsolvedValue;
+					int slowestLoss = -1;
+					bool canDraw = false;
+					for (uint8_t column = 0; column < numColumns; ++column)
+					{
+						if (heights[columns[column]] == numRows)
+						{
+							continue;
+						}
+
+						// the child's value is for the other player
+						const uint8_t childValue = allValues[getChildIndex(column)];
+						if (childValue == drawValue)
+						{
+							canDraw = true;
+						}
+						else if (childValue % 2 == 0)
+						{
+							fastestWin = std::min(fastestWin, (childValue - 2) / 2 + 1);
+						}
+						else
+						{
+							slowestLoss = std::max(slowestLoss, (childValue - 3) / 2 + 1);
+						}
+					}
+
+					allValues[index] =
+						fastestWin != unsolvedValue ? encodeWin(fastestWin) :
+						canDraw ? drawValue :
+						encodeLoss(slowestLoss);
+				}
+				std::vector<uint32_t>{}.swap(plies[ply]);
+			}
+
+			// keep the reachable positions only
+			const size_t numWords = (tablebase.numIndices + 63) / 64;
+			tablebase.isReachable.assign(numWords, 0);
+			tablebase.blockRanks.assign(numWords / blockWords + 1, 0);
+			for (uint32_t index = 0; index < tablebase.numIndices; ++index)
+			{
+				if (index % (64 * blockWords) == 0)
+				{
+					tablebase.blockRanks[index / (64 * blockWords)] = static_cast<uint32_t>(tablebase.values.size());
+				}
+				if (allValues[index] != unreachableValue)
+				{
+					tablebase.isReachable[index / 64] |= uint64_t{1} << (index % 64);
+					tablebase.values.push_back(allValues[index]);
+				}
+			}
+			return tablebase;
+		}
+
+		Tablebase::Tablebase(const std::string& path) :
+			numColumns{0},
+			numRows{0},
+			winLength{0},
+			numIndices{0}
+		{
+			std::ifstream file{path, std::ios::binary};
+			if (!file)
+			{
+				throw std::runtime_error("Tablebase: can't open " + path);
+			}
+
+			Header header;
+			file.read(reinterpret_cast<char*>(&header), sizeof(header));
+			const bool isTablebase = file &&
+				std::memcmp(header.magic, tablebaseMagic, sizeof(tablebaseMagic)) == 0 &&
+				isSupported(header.numColumns, header.numRows) &&
+				header.winLength >= FourAcross::minWinLength && header.winLength <= header.numColumns;
+			if (!isTablebase)
+			{
+				throw std::runtime_error("Tablebase: " + path + " isn't a tablebase");
+			}
+
+			// the board decides how many position numbers there are; probe relies on it
+			*this = Tablebase{header.numColumns, header.numRows, header.winLength};
+			if (header.numIndices != numIndices || header.numPositions > numIndices)
+			{
+				throw std::runtime_error("Tablebase: " + path + " has an invalid header");
+			}
+			const size_t numWords = (numIndices + 63) / 64;
+			isReachable.resize(numWords);
+			blockRanks.resize(numWords / blockWords + 1);
+			values.resize(static_cast<size_t>(header.numPositions));
+			file.read(reinterpret_cast<char*>(isReachable.data()), isReachable.size() * sizeof(uint64_t));
+			file.read(reinterpret_cast<char*>(blockRanks.data()), blockRanks.size() * sizeof(uint32_t));
+			file.read(reinterpret_cast<char*>(values.data()), values.size());
+			if (!file)
+			{
+				throw std::runtime_error("Tablebase: " + path + " is truncated");
+			}
+
+			// probe reads values at ranks taken from the bitmap and block ranks, so they must agree
+			// with each other and with the number of values before any probe can trust them
+			uint64_t rank = 0;
+			for (size_t word = 0; word < numWords; ++word)
+			{
+				if (word % blockWords == 0 && blockRanks[word / blockWords] != rank)
+				{
+					throw std::runtime_error("Tablebase: " + path + " has inconsistent ranks");
+				}
+				rank += countBits(isReachable[word]);
+			}
+			const uint64_t unusedBits = numIndices % 64 == 0 ? 0 : ~uint64_t{0} << (numIndices % 64);
+			const bool isValueValid = std::none_of(values.begin(), values.end(), [](uint8_t value)
+				{
+					return value == unreachableValue || value == unsolvedValue;
+				});
+			if (rank != values.size() || (isReachable.back() & unusedBits) != 0 || !isValueValid)
+			{
+				throw std::runtime_error("Tablebase: " + path + " has inconsistent positions");
+			}
+		}
+
+		void Tablebase::write(const std::string& path) const
+		{
+			Header header{};
+			std::memcpy(header.magic, tablebaseMagic, sizeof(tablebaseMagic));
+			header.numColumns = numColumns;
+			header.numRows = numRows;
+			header.winLength = winLength;
+			header.numIndices = numIndices;
+			header.numPositions = values.size();
+
+			std::ofstream file{path, std::ios::binary | std::ios::trunc};
+			file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+			file.write(reinterpret_cast<const char*>(isReachable.data()), isReachable.size() * sizeof(uint64_t));
+			file.write(reinterpret_cast<const char*>(blockRanks.data()), blockRanks.size() * sizeof(uint32_t));
+			file.write(reinterpret_cast<const char*>(values.data()), values.size());
+			file.flush();
+			if (!file)
+			{
+				throw std::runtime_error("Tablebase::write: can't write " + path);
+			}
+		}
+
+		bool Tablebase::probe(const FourAcross& game, Entry& entry) const noexcept
+		{
+			if (game.getNumColumns() != numColumns || game.getNumRows() != numRows ||
+				game.getWinLength() != winLength || game.getNumPlayers() != 2)
+			{
+				return false;
+			}
+
+			const uint32_t index = getIndex(game);
+			const size_t word = index / 64;
+			const uint64_t bit = uint64_t{1} << (index % 64);
+			if ((isReachable[word] & bit) == 0)
+			{
+				return false;
+			}
+
+			size_t rank = blockRanks[word / blockWords] + countBits(isReachable[word] & (bit - 1));
+			for (size_t before = word - word % blockWords; before < word; ++before)
+			{
+				rank += countBits(isReachable[before]);
+			}
+
+			const uint8_t value = values[rank];
+			if (value == drawValue)
+			{
+				entry = {Outcome::draw, static_cast<uint8_t>(numColumns * numRows - game.getNumTurns())};
+			}
+			else
+			{
+				entry = {value % 2 == 0 ? Outcome::loss : Outcome::win, static_cast<uint8_t>((value - 2) / 2)};
+			}
+			return true;
+		}
+
+		uint32_t Tablebase::getIndex(const FourAcross& game) const noexcept
+		{
+			const Board& board = game.getBoard();
+			const uint8_t currentPlayer = game.getCurrentPlayer();
+			const uint32_t numStates = (1u << (numRows + 1)) - 1;
+			uint32_t index = 0;
+			uint32_t power = 1;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				const uint8_t height = board.getColumnHeightUnchecked(column);
+				uint32_t state = 1u << height;
+				for (uint8_t row = 0; row < height; ++row)
+				{
+					if (board.getDiskOwnerAtUnchecked(column, row) == currentPlayer)
+					{
+						state |= 1u << row;
+					}
+				}
+				index += (state - 1) * power;
+				power *= numStates;
+			}
+			return index;
+		}
+
+		bool Tablebase::isSupported(uint8_t numColumns, uint8_t numRows) noexcept
+		{
+			if (numColumns < Board::minColumns || numRows < Board::minRows || numColumns * (numRows + 1) > 64)
+			{
+				return false;
+			}
+
+			const uint64_t numStates = (uint64_t{1} << (numRows + 1)) - 1;
+			uint64_t numIndices = 1;
+			for (uint8_t column = 0; column < numColumns; ++column)
+			{
+				numIndices *= numStates;
+				if (numIndices > maxIndices)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+	}
+}
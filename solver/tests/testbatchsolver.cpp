@@ -0,0 +1,103 @@
+#include "four-across/solver/batchsolver.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	// random 6x5 positions, as move lists and as snapshots
+	std::default_random_engine engine{3};
+	std::vector<std::vector<uint8_t>> moveLists;
+	std::vector<GameSnapshot> snapshots;
+	for (int i = 0; i < 60; ++i)
+	{
+		FourAcross game{2, 1, 6, 5};
+		std::vector<uint8_t> moves;
+		for (int turn = 0; turn < 14 && !game.hasWinner(); ++turn)
+		{
+			const uint8_t column = engine() % 6;
+			moves.push_back(column);
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		moveLists.push_back(moves);
+		snapshots.push_back(game.snapshot());
+	}
+
+	BatchSolver batchSolver{3, 1 << 20};
+	assert(batchSolver.getNumThreads() == 3);
+
+	{
+		// results come back in order and match a single solver
+		Solver solver{1 << 20};
+		std::vector<SearchResult> results;
+		batchSolver.solve(moveLists.data(), moveLists.size(), 6, 5, 4, {}, [&](size_t index, const SearchResult& result)
+			{
+				assert(index == results.size());
+				results.push_back(result);
+			});
+		assert(results.size() == moveLists.size());
+
+		for (size_t i = 0; i < snapshots.size(); ++i)
+		{
+			const SearchResult expected = solver.solve(FourAcross{snapshots[i]});
+			assert(results[i].isSolved && expected.isSolved);
+			assert(results[i].score == expected.score);
+		}
+
+		// snapshots give the same values, and the pool can be used again
+		size_t numResults{0};
+		batchSolver.solve(snapshots.data(), snapshots.size(), {}, [&](size_t index, const SearchResult& result)
+			{
+				assert(index == numResults++);
+				assert(result.score == results[index].score);
+			});
+		assert(numResults == snapshots.size());
+	}
+
+	{
+		// a fixed depth limits every search
+		batchSolver.solve(moveLists.data(), moveLists.size(), 7, 6, 4, {4, 0}, [](size_t, const SearchResult& result)
+			{
+				assert(result.depth <= 4);
+			});
+	}
+
+	{
+		// an exception from the handler stops the batch and reaches the caller
+		bool threw{false};
+		try
+		{
+			batchSolver.solve(snapshots.data(), snapshots.size(), {}, [](size_t index, const SearchResult&)
+				{
+					if (index == 5)
+					{
+						throw std::runtime_error{"stop"};
+					}
+				});
+		}
+		catch (std::runtime_error&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		GameSnapshot multiplayer = FourAcross{3, 1, 5, 4}.snapshot();
+		threw = false;
+		try
+		{
+			batchSolver.solve(&multiplayer, 1, {}, [](size_t, const SearchResult&) {});
+		}
+		catch (std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,153 @@
+#include "four-across/solver/knowledgeevaluator.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <cassert>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+	using Outcome = Knowledge::Outcome;
+
+	{
+		// an immediate win is found, and two threats of the other player lose
+		KnowledgeEvaluator evaluator{7, 6};
+		FourAcross game{2, 1, 7, 6};
+		for (auto column : {1, 6, 2, 6, 3})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		Knowledge knowledge = evaluator.evaluate(game);
+		assert(knowledge.outcome == Outcome::loss);
+		assert(knowledge.allowedMoves == 0);
+
+		game.takeTurn(game.getCurrentPlayer(), 6);
+		knowledge = evaluator.evaluate(game);
+		assert(knowledge.outcome == Outcome::win);
+		assert(knowledge.bestMove == 0 || knowledge.bestMove == 4);
+
+		// a single threat forces the move that blocks it
+		FourAcross blocked{2, 1, 7, 6};
+		for (auto column : {3, 0, 3, 0, 3})
+		{
+			blocked.takeTurn(blocked.getCurrentPlayer(), column);
+		}
+		knowledge = evaluator.evaluate(blocked);
+		assert(knowledge.allowedMoves == 1 << 3);
+		assert(knowledge.bestMove == 3);
+	}
+
+	{
+		// whatever the rules prove agrees with the solver on random positions
+		Solver solver{1 << 20};
+		std::default_random_engine engine{19};
+		const uint8_t sizes[][2] = {{5, 4}, {6, 5}, {7, 4}};
+		int numDecided = 0;
+		int numPositions = 0;
+		double seconds = 0;
+		for (const auto& size : sizes)
+		{
+			KnowledgeEvaluator evaluator{size[0], size[1]};
+			for (int i = 0; i < 100; ++i)
+			{
+				FourAcross game{2, 1, size[0], size[1]};
+				const int numTurns = size[0] * size[1] / 3 + engine() % (size[0] * size[1] / 2);
+				for (int turn = 0; turn < numTurns && !game.hasWinner() && !game.boardFull(); ++turn)
+				{
+					uint8_t column = engine() % size[0];
+					while (game.getBoard().getColumnHeight(column) == size[1])
+					{
+						column = (column + 1) % size[0];
+					}
+					game.takeTurn(game.getCurrentPlayer(), column);
+				}
+
+				const auto startTime = std::chrono::steady_clock::now();
+				const Knowledge knowledge = evaluator.evaluate(game);
+				seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - startTime).count();
+				++numPositions;
+				if (game.hasWinner() || game.boardFull())
+				{
+					continue;
+				}
+
+				const SearchResult expected = solver.solve(game);
+				assert(expected.isSolved);
+				const auto scoreAfter = [&solver, &game](uint8_t column)
+				{
+					FourAcross played{game};
+					played.takeTurn(played.getCurrentPlayer(), column);
+					return -solver.solve(played).score;
+				};
+				switch (knowledge.outcome)
+				{
+				case Outcome::win:
+					assert(expected.score > 0 && scoreAfter(knowledge.bestMove) > 0);
+					break;
+				case Outcome::loss:
+					assert(expected.score < 0);
+					break;
+				case Outcome::draw:
+					assert(expected.score == 0 && scoreAfter(knowledge.bestMove) == 0);
+					break;
+				case Outcome::atLeastDraw:
+					assert(expected.score >= 0 && scoreAfter(knowledge.bestMove) >= 0);
+					break;
+				case Outcome::atMostDraw:
+					assert(expected.score <= 0);
+					break;
+				case Outcome::unknown:
+					break;
+				}
+				numDecided += knowledge.outcome != Outcome::unknown;
+
+				// moves the rules rule out lose
+				for (uint8_t column = 0; column < size[0]; ++column)
+				{
+					const bool isLegal = game.getBoard().getColumnHeight(column) < size[1];
+					if (isLegal && (knowledge.allowedMoves & (uint64_t{1} << column)) == 0 && knowledge.outcome != Outcome::win)
+					{
+						assert(scoreAfter(column) < 0);
+					}
+				}
+			}
+		}
+		std::cout << numDecided << " of " << numPositions << " positions bounded by rules, "
+			<< (seconds > 0 ? numPositions / seconds : 0) << " positions/s\n";
+	}
+
+	{
+		bool threw = false;
+		try
+		{
+			KnowledgeEvaluator{9, 8};
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+
+		// games that don't match the evaluator are rejected by evaluate itself
+		const KnowledgeEvaluator evaluator{7, 6};
+		for (const auto& game : {FourAcross{2, 1, 5, 4}, FourAcross{2, 1, 7, 6, 3}, FourAcross{3, 1, 7, 6}})
+		{
+			threw = false;
+			try
+			{
+				evaluator.evaluate(game);
+			}
+			catch (const std::invalid_argument&)
+			{
+				threw = true;
+			}
+			assert(threw);
+		}
+	}
+
+	std::cout << "tests passed\n";
+}
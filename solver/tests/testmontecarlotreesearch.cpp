@@ -0,0 +1,82 @@
+#include "four-across/solver/montecarlotreesearch.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	{
+		// an open three wins at once, and the other player blocks a three
+		MonteCarloTreeSearch search{size_t{16} << 20};
+		FourAcross game{2, 1, 7, 6};
+		for (auto column : {1, 1, 2, 2, 3})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		MonteCarloResult result = search.search(game, {0, 20000});
+		assert(result.bestMove == 0 || result.bestMove == 4);
+		assert(result.numIterations == 20000);
+		assert(!result.isArenaFull);
+
+		game.takeTurn(game.getCurrentPlayer(), 3);
+		result = search.search(game, {0, 20000});
+		assert(result.bestMove == 0 || result.bestMove == 4);
+		assert(result.value > 0.9);
+
+		FourAcross blocking{2, 1, 7, 6};
+		for (auto column : {6, 0, 6, 0, 6})
+		{
+			blocking.takeTurn(blocking.getCurrentPlayer(), column);
+		}
+		result = search.search(blocking, {0, 20000});
+		assert(result.bestMove == 6);
+	}
+
+	{
+		// several threads keep to a time budget on a board and player count no solver handles
+		MonteCarloTreeSearch search{size_t{16} << 20, 4};
+		FourAcross game{3, 1, 9, 7};
+		while (!game.hasWinner() && !game.boardFull())
+		{
+			const MonteCarloResult result = search.search(game, {0.02, 0});
+			assert(result.seconds < 0.5);
+			assert(game.takeTurn(game.getCurrentPlayer(), result.bestMove) == FourAcross::TurnResult::success);
+		}
+		std::cout << "three player game over after " << game.getNumTurns() << " turns, winner " << int{game.getWinner()} << "\n";
+
+		const MonteCarloResult result = search.search(game, {0.02, 0});
+		assert(result.bestMove == Solver::noMove);
+	}
+
+	{
+		// a full arena stops the tree growing but not the search
+		MonteCarloTreeSearch search{4096, 2};
+		FourAcross game{2, 1, 7, 6};
+		const MonteCarloResult result = search.search(game, {0, 5000});
+		assert(result.isArenaFull);
+		assert(result.numNodes <= search.getArenaSize());
+		assert(result.bestMove < 7);
+		std::cout << result.iterationsPerSecond << " iterations/s\n";
+	}
+
+	{
+		bool threw = false;
+		try
+		{
+			MonteCarloTreeSearch search{4096};
+			search.search(FourAcross{}, {0, 0});
+		}
+		catch (const std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,111 @@
+#include "four-across/solver/openingbook.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	const std::string path = "testopeningbook.book";
+	Solver solver{1 << 20};
+
+	// every position of a 5x4 game up to 3 turns in, solved exactly
+	std::vector<OpeningBook::Position> positions;
+	std::vector<FourAcross> games;
+	FourAcross game{2, 1, 5, 4};
+	games.push_back(game);
+	for (uint8_t first = 0; first < 5; ++first)
+	{
+		for (uint8_t second = 0; second < 5; ++second)
+		{
+			for (uint8_t third = 0; third < 5; ++third)
+			{
+				FourAcross played{2, 1, 5, 4};
+				for (auto column : {first, second, third})
+				{
+					played.takeTurn(played.getCurrentPlayer(), column);
+				}
+				games.push_back(played);
+			}
+		}
+	}
+	for (const auto& position : games)
+	{
+		const SearchResult result = solver.solve(position);
+		assert(result.isSolved);
+		const zobrist::CanonicalKey key = position.getCanonicalKey();
+		const uint8_t bestMove = key.isMirrored ? position.getBoard().getMirroredColumn(result.bestMove) : result.bestMove;
+		positions.push_back({key.key, {result.score, bestMove, OpeningBook::solvedDepth}});
+	}
+	// transposed and mirrored positions are written once
+	OpeningBook::write(path, 5, 4, 4, 3, positions);
+
+	{
+		OpeningBook book{path};
+		assert(book.getNumColumns() == 5 && book.getNumRows() == 4);
+		assert(book.getWinLength() == 4 && book.getMaxPly() == 3);
+		std::set<uint64_t> keys;
+		for (const auto& position : positions)
+		{
+			keys.insert(position.key);
+		}
+		assert(book.getNumEntries() == keys.size());
+
+		for (size_t i = 0; i < games.size(); ++i)
+		{
+			OpeningBook::Entry entry;
+			assert(book.probe(games[i], entry));
+			assert(entry.score == positions[i].entry.score);
+			assert(entry.bestMove < 5);
+			if (!games[i].hasWinner())
+			{
+				// the book's move keeps the position's value
+				FourAcross played = games[i];
+				played.takeTurn(played.getCurrentPlayer(), entry.bestMove);
+				assert(solver.solve(played).score == -entry.score + (entry.score > 0 ? -1 : entry.score < 0 ? 1 : 0));
+			}
+			assert(entry.depth == OpeningBook::solvedDepth);
+		}
+
+		// positions that aren't in the book, or are of other games, aren't found
+		OpeningBook::Entry entry;
+		FourAcross deeper = games.back();
+		deeper.takeTurn(deeper.getCurrentPlayer(), 0);
+		assert(!book.probe(deeper, entry));
+		assert(!book.probe(FourAcross{2, 1, 6, 4}, entry));
+		assert(!book.probe(FourAcross{2, 1, 5, 4, 3}, entry));
+
+		// a solver with the book answers from it without searching
+		solver.setOpeningBook(&book);
+		const SearchResult result = solver.solve(games[1]);
+		assert(result.numNodes == 0);
+		assert(result.isSolved);
+		assert(result.score == positions[1].entry.score);
+		solver.setOpeningBook(nullptr);
+	}
+
+	{
+		// files that aren't books are rejected
+		std::ofstream{path, std::ios::binary | std::ios::trunc} << "not a book";
+		bool threw{false};
+		try
+		{
+			OpeningBook book{path};
+		}
+		catch (std::runtime_error&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+	std::remove(path.c_str());
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,102 @@
+#include "four-across/solver/proofnumbersearch.hpp"
+#include "four-across/solver/solver.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	ProofNumberSearch search{size_t{16} << 20};
+
+	{
+		// outcomes of random small board positions match the alpha-beta solver
+		Solver solver{1 << 20};
+		std::default_random_engine engine{13};
+		for (int i = 0; i < 150; ++i)
+		{
+			FourAcross game{2, 1, 5, 4};
+			const int numTurns = 6 + engine() % 6;
+			for (int turn = 0; turn < numTurns && !game.hasWinner(); ++turn)
+			{
+				game.takeTurn(game.getCurrentPlayer(), engine() % 5);
+			}
+
+			const ProofResult result = search.solve(game);
+			const SearchResult expected = solver.solve(game);
+			assert(expected.isSolved);
+			if (Solver::isWinScore(expected.score))
+			{
+				assert(result.outcome == ProofResult::Outcome::win);
+				// the proven move wins too
+				FourAcross played{game};
+				played.takeTurn(played.getCurrentPlayer(), result.bestMove);
+				assert(Solver::isLossScore(solver.solve(played).score));
+			}
+			else if (Solver::isLossScore(expected.score))
+			{
+				assert(result.outcome == ProofResult::Outcome::loss);
+			}
+			else
+			{
+				assert(result.outcome == ProofResult::Outcome::draw);
+			}
+			assert(result.proofSize > 0);
+		}
+	}
+
+	{
+		// an open three on a wide board wins at once or next turn
+		FourAcross game{2, 1, 60, 8};
+		for (auto column : {30, 30, 31, 31, 32, 59})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		const ProofResult result = search.solve(game);
+		assert(result.outcome == ProofResult::Outcome::win);
+		assert(result.bestMove == 29 || result.bestMove == 33);
+		assert(result.proofSize == 2);
+	}
+
+	{
+		// a small arena is collected and reused
+		ProofNumberSearch smallSearch{1 << 14};
+		FourAcross game{2, 1, 5, 4};
+		const ProofResult result = smallSearch.solve(game);
+		assert(result.numCollections > 0);
+		assert(result.outcome == ProofResult::Outcome::draw || result.outcome == ProofResult::Outcome::unknown);
+
+		// and a node budget stops the search
+		const ProofResult limited = search.solve(FourAcross{2, 1, 40, 10}, 1000);
+		assert(limited.outcome == ProofResult::Outcome::unknown);
+		assert(limited.numNodes < 1000 + 40);
+	}
+
+	{
+		bool threw{false};
+		try
+		{
+			search.solve(FourAcross{3, 1, 5, 4});
+		}
+		catch (std::invalid_argument&)
+		{
+			threw = true;
+		}
+		assert(threw);
+	}
+
+	{
+		// proofs on larger boards, with a budget
+		FourAcross game{2, 1, 9, 7};
+		const ProofResult result = search.solve(game, 300000);
+		std::cout << "9x7: outcome " << static_cast<int>(result.outcome) << ", " << result.numNodes << " nodes, "
+			<< result.numCollections << " collections, proof size " << result.proofSize << ", "
+			<< result.nodesPerSecond << " nodes/s\n";
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,145 @@
+#include "four-across/solver/solver.hpp"
+
+#include <cassert>
+#include <iostream>
+#include <random>
+#include <unordered_map>
+
+namespace
+{
+	// Plain minimax with a memo of every position: 1 if the player to move wins, -1 if they lose.
+	int referenceValue(game::FourAcross& game, std::unordered_map<uint64_t, int>& memo)
+	{
+		if (game.hasWinner())
+		{
+			return -1;
+		}
+		if (game.boardFull())
+		{
+			return 0;
+		}
+
+		const auto found = memo.find(game.getKey());
+		if (found != memo.end())
+		{
+			return found->second;
+		}
+
+		int best = -1;
+		for (uint8_t column = 0; column < game.getNumColumns(); ++column)
+		{
+			if (game.getBoard().getColumnHeight(column) < game.getNumRows())
+			{
+				game.makeMove(column);
+				best = std::max(best, -referenceValue(game, memo));
+				game.unmakeMove();
+			}
+		}
+		memo[game.getKey()] = best;
+		return best;
+	}
+
+	int sign(int value)
+	{
+		return (value > 0) - (value < 0);
+	}
+}
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	Solver solver{1 << 20};
+
+	{
+		// player 1 wins at once in column 3
+		FourAcross game{2, 1, 7, 6};
+		for (auto column : {0, 0, 1, 1, 2, 2})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		const uint32_t numTurns = game.getNumTurns();
+		const SearchResult result = solver.solve(game);
+		assert(result.bestMove == 3);
+		assert(result.score == Solver::winScore - 1);
+		assert(result.isSolved);
+		assert(game.getNumTurns() == numTurns);
+	}
+
+	{
+		// player 2 must block column 3 or lose
+		FourAcross game{2, 1, 7, 6};
+		for (auto column : {0, 6, 1, 6, 2})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		const SearchResult result = solver.solve(game, {6, 0});
+		assert(result.bestMove == 3);
+		assert(!Solver::isLossScore(result.score));
+	}
+
+	{
+		// the standard rules on a 5x4 board are a draw
+		FourAcross game{2, 1, 5, 4};
+		const SearchResult result = solver.solve(game);
+		assert(result.isSolved);
+		assert(result.score == 0);
+		std::cout << "5x4: " << result.numNodes << " nodes, " << result.nodesPerSecond << " nodes/s\n";
+	}
+
+	{
+		// a node budget stops the search early but still gives a move
+		FourAcross game{2, 1, 9, 7};
+		const SearchResult result = solver.solve(game, {0, 1000});
+		assert(!result.isSolved);
+		assert(result.bestMove < 9);
+		assert(result.numNodes <= 1001);
+	}
+
+	{
+		// solved values of random positions match plain minimax, on boards with short and long win lengths
+		std::default_random_engine engine{5};
+		std::unordered_map<uint64_t, int> memo[2];
+		const uint8_t winLengths[] = {3, 4};
+		for (int i = 0; i < 200; ++i)
+		{
+			const uint8_t winLength = winLengths[i % 2];
+			FourAcross game{2, 1, 5, 4, winLength};
+			for (int turn = 0; turn < 8 && !game.hasWinner(); ++turn)
+			{
+				game.takeTurn(game.getCurrentPlayer(), engine() % 5);
+			}
+
+			const SearchResult result = solver.solve(game);
+			assert(result.isSolved);
+			assert(sign(result.score) == referenceValue(game, memo[i % 2]));
+		}
+	}
+
+	{
+		// Lazy SMP gives the same solved values as one thread
+		Solver parallelSolver{1 << 20, 4};
+		assert(parallelSolver.getNumThreads() == 4);
+		std::default_random_engine engine{11};
+		for (int i = 0; i < 40; ++i)
+		{
+			FourAcross game{2, 1, 6, 5};
+			for (int turn = 0; turn < 12 && !game.hasWinner(); ++turn)
+			{
+				game.takeTurn(game.getCurrentPlayer(), engine() % 6);
+			}
+
+			const SearchResult expected = solver.solve(game);
+			const SearchResult result = parallelSolver.solve(game);
+			assert(result.isSolved && expected.isSolved);
+			assert(sign(result.score) == sign(expected.score));
+		}
+
+		FourAcross game{2, 1, 7, 6};
+		const SearchResult result = parallelSolver.solve(game, {12, 0});
+		std::cout << "7x6 depth 12 with 4 threads: " << result.numNodes << " nodes, " << result.nodesPerSecond << " nodes/s\n";
+	}
+
+	std::cout << "tests passed\n";
+}
@@ -0,0 +1,146 @@
+#include "four-across/solver/solver.hpp"
+#include "four-across/solver/tablebase.hpp"
+
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+int main(int argc, char* argv[])
+{
+	using namespace game;
+	using namespace game::solver;
+
+	assert(Tablebase::isSupported(5, 4));
+	assert(!Tablebase::isSupported(6, 4));
+	assert(!Tablebase::isSupported(7, 6));
+
+	bool threw{false};
+	try
+	{
+		Tablebase::generate(7, 6, 4);
+	}
+	catch (std::invalid_argument&)
+	{
+		threw = true;
+	}
+	assert(threw);
+
+	const std::string path = "testtablebase.tb";
+	Tablebase::generate(5, 4, 4).write(path);
+	const Tablebase tablebase{path};
+
+	{
+		// files whose header, bitmap or ranks don't agree are rejected instead of probed
+		std::ifstream in{path, std::ios::binary};
+		const std::vector<char> bytes{std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+		uint32_t numIndices;
+		std::memcpy(&numIndices, bytes.data() + 12, sizeof(numIndices));
+		const size_t bitmapOffset = 24;
+		const size_t ranksOffset = bitmapOffset + (numIndices + 63) / 64 * sizeof(uint64_t);
+
+		const auto isRejected = [&path](std::vector<char> corrupted)
+		{
+			std::ofstream out{path, std::ios::binary | std::ios::trunc};
+			out.write(corrupted.data(), corrupted.size());
+			out.close();
+			try
+			{
+				Tablebase loaded{path};
+			}
+			catch (std::runtime_error&)
+			{
+				return true;
+			}
+			return false;
+		};
+
+		std::vector<char> corrupted = bytes;
+		corrupted[10] = 9; // win length longer than the board
+		const bool rejectsWinLength = isRejected(corrupted);
+		assert(rejectsWinLength);
+
+		corrupted = bytes;
+		++corrupted[12]; // more position numbers than the board has
+		const bool rejectsIndices = isRejected(corrupted);
+		assert(rejectsIndices);
+
+		corrupted = bytes;
+		corrupted[bitmapOffset + 100] ^= 0x10; // one reachable position too many or too few
+		const bool rejectsBitmap = isRejected(corrupted);
+		assert(rejectsBitmap);
+
+		corrupted = bytes;
+		corrupted[ranksOffset + 3 * sizeof(uint32_t)] += 1; // a block rank past its popcounts
+		const bool rejectsRanks = isRejected(corrupted);
+		assert(rejectsRanks);
+
+		const bool acceptsOriginal = !isRejected(bytes);
+		assert(acceptsOriginal);
+	}
+	std::remove(path.c_str());
+	assert(tablebase.getNumColumns() == 5 && tablebase.getNumRows() == 4 && tablebase.getWinLength() == 4);
+
+	Tablebase::Entry entry;
+	assert(tablebase.probe(FourAcross{2, 1, 5, 4}, entry));
+	assert(entry.outcome == Tablebase::Outcome::draw && entry.distance == 20);
+	assert(!tablebase.probe(FourAcross{2, 1, 6, 4}, entry));
+	assert(!tablebase.probe(FourAcross{2, 1, 5, 4, 3}, entry));
+	assert(!tablebase.probe(FourAcross{3, 1, 5, 4}, entry));
+
+	{
+		// results match the solver, whoever went first
+		Solver solver{1 << 20};
+		std::default_random_engine engine{7};
+		for (int i = 0; i < 300; ++i)
+		{
+			FourAcross game{2, static_cast<uint8_t>(1 + i % 2), 5, 4};
+			const int numTurns = engine() % 16;
+			for (int turn = 0; turn < numTurns && !game.hasWinner(); ++turn)
+			{
+				game.takeTurn(game.getCurrentPlayer(), engine() % 5);
+			}
+
+			assert(tablebase.probe(game, entry));
+			const SearchResult expected = solver.solve(game);
+			assert(expected.isSolved);
+			switch (entry.outcome)
+			{
+			case Tablebase::Outcome::win:
+				assert(expected.score == Solver::winScore - entry.distance);
+				break;
+			case Tablebase::Outcome::loss:
+				assert(expected.score == -(Solver::winScore - entry.distance));
+				break;
+			case Tablebase::Outcome::draw:
+				assert(expected.score == 0);
+				break;
+			}
+		}
+	}
+
+	{
+		// a solver with the tablebase plays its best moves without searching
+		Solver solver{1 << 20};
+		solver.setTablebase(&tablebase);
+		FourAcross game{2, 1, 5, 4};
+		for (auto column : {2, 2, 1})
+		{
+			game.takeTurn(game.getCurrentPlayer(), column);
+		}
+		const SearchResult result = solver.solve(game);
+		assert(result.numNodes == 0 && result.isSolved);
+		assert(result.bestMove < 5);
+
+		game.takeTurn(game.getCurrentPlayer(), result.bestMove);
+		const SearchResult reply = solver.solve(game);
+		assert(reply.score == -result.score + (result.score > 0 ? -1 : result.score < 0 ? 1 : 0));
+	}
+
+	std::cout << "tests passed\n";
+}